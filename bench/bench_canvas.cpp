@@ -0,0 +1,383 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Measures the drawing cost of the custom-drawn widgets: the axis bars (with and without
+ * the cached static layers), the trail plots, the 2D stick views and the overview.
+ *
+ * Usage: bench-canvas [FRAMES]
+ *
+ * Renders into image surfaces, so it doesn't need a display. Allocations are counted
+ * through malloc, so the ones done inside cairo and pixman are included.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cairo.h>
+#include <cairomm/cairomm.h>
+
+#include "axis_renderer.hpp"
+#include "overview_renderer.hpp"
+#include "stick_renderer.hpp"
+#include "trail_renderer.hpp"
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+using clock_type = std::chrono::steady_clock;
+
+
+namespace {
+
+    std::atomic<std::uint64_t> allocations = 0;
+
+} // namespace
+
+
+#ifdef __GLIBC__
+
+extern "C" {
+
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* ptr, std::size_t size);
+
+
+    void*
+    malloc(std::size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+
+    void*
+    calloc(std::size_t count,
+           std::size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+
+    void*
+    realloc(void* ptr,
+            std::size_t size)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+
+} // extern "C"
+
+#endif // __GLIBC__
+
+
+namespace {
+
+    struct Size {
+        int width;
+        int height;
+        double scale;
+    };
+
+
+    Colors
+    make_colors()
+    {
+        Colors c;
+        c.background.set_rgba(0.1, 0.1, 0.1);
+        c.value.set_rgba(1.0, 1.0, 1.0);
+        c.min.set_rgba(0.3, 0.6, 1.0);
+        c.max.set_rgba(1.0, 0.4, 0.3);
+        c.fuzz.set_rgba(0.8, 0.8, 0.2);
+        c.flat.set_rgba(0.4, 0.9, 0.4);
+        return c;
+    }
+
+
+    evdev::AbsInfo
+    make_orig(int fuzz)
+    {
+        evdev::AbsInfo info;
+        info.val = 0;
+        info.min = -32768;
+        info.max = 32767;
+        info.fuzz = fuzz;
+        info.flat = 1024;
+        info.res = 0;
+        return info;
+    }
+
+
+    // A stick being moved around during calibration.
+    int
+    stick_value(unsigned i)
+    {
+        return static_cast<int>(30000 * std::sin(i * 0.01));
+    }
+
+
+    Cairo::RefPtr<Cairo::Context>
+    make_context(const Size& size)
+    {
+        auto surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32,
+                                                   size.width * size.scale,
+                                                   size.height * size.scale);
+        cairo_surface_set_device_scale(surface->cobj(), size.scale, size.scale);
+        return Cairo::Context::create(surface);
+    }
+
+
+    string
+    size_name(const Size& size)
+    {
+        string name = std::to_string(size.width) + "x" + std::to_string(size.height);
+        if (size.scale != 1)
+            name += " @" + std::to_string(int(size.scale)) + "x";
+        return name;
+    }
+
+
+    void
+    print_header(unsigned frames)
+    {
+        cout << frames << " frames per case\n\n";
+        cout << std::left << std::setw(40) << "case"
+             << std::right << std::setw(12) << "us/frame"
+             << std::setw(12) << "frames/s"
+             << std::setw(14) << "allocs/frame"
+             << std::setw(16) << "static renders" << endl;
+    }
+
+
+    /*
+     * Runs step(i) for each frame, and reports the time and the allocations per frame.
+     * The static renders are only reported if given.
+     */
+    template<typename Step>
+    void
+    measure(const string& name,
+            unsigned frames,
+            Step step,
+            const std::int64_t* static_renders = nullptr)
+    {
+        // Warm up, so lazily allocated state isn't counted.
+        step(0u);
+
+        const auto allocs_before = allocations.load(std::memory_order_relaxed);
+        const auto start = clock_type::now();
+        for (unsigned i = 1; i <= frames; ++i)
+            step(i);
+        const double seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        const auto allocs = allocations.load(std::memory_order_relaxed) - allocs_before;
+
+        cout << std::left << std::setw(40) << name
+             << std::right << std::fixed
+             << std::setw(12) << std::setprecision(2) << seconds * 1e6 / frames
+             << std::setw(12) << std::setprecision(0) << frames / seconds
+             << std::setw(14) << std::setprecision(2) << double(allocs) / frames;
+        if (static_renders)
+            cout << std::setw(16) << *static_renders;
+        else
+            cout << std::setw(16) << "-";
+        cout << endl;
+    }
+
+
+    /*
+     * The value changes every frame, and the calc limits grow every few hundred frames,
+     * which forces the static layers to be re-rendered.
+     */
+    void
+    bench_axis(const Size& size,
+               unsigned frames,
+               bool cached,
+               bool flat_centered,
+               int fuzz)
+    {
+        auto cr = make_context(size);
+
+        AxisRenderer renderer{make_orig(fuzz)};
+        renderer.set_colors(make_colors());
+        renderer.set_flat_centered(flat_centered);
+
+        auto calc = make_orig(fuzz);
+        calc.min = calc.max = 0;
+
+        string name = "axis " + size_name(size)
+            + (cached ? " cached" : " uncached")
+            + (flat_centered ? " centered" : " zero")
+            + (fuzz ? " fuzz" : "");
+
+        std::int64_t static_renders = 0;
+        measure(name, frames,
+                [&](unsigned i)
+                {
+                    calc.val = stick_value(i);
+                    if (i % 500 == 0) {
+                        calc.min = std::min(calc.min, calc.val - 1);
+                        calc.max = std::max(calc.max, calc.val + 1);
+                    }
+                    renderer.update(calc);
+                    if (cached)
+                        renderer.draw(cr, size.width, size.height);
+                    else
+                        renderer.draw_uncached(cr, size.width, size.height);
+                    static_renders = cached ? renderer.get_static_renders() : i + 1;
+                },
+                &static_renders);
+    }
+
+
+    // A full buffer of 1 kHz history, with 16 new samples per frame (1 kHz at 60 FPS).
+    void
+    bench_trail(const Size& size,
+                unsigned frames)
+    {
+        auto cr = make_context(size);
+
+        TrailRenderer renderer;
+        renderer.set_enabled(true);
+        renderer.set_colors(make_colors());
+        renderer.set_range(-32768, 32767);
+
+        std::int64_t time = 0;
+        unsigned sample = 0;
+        for (; time < 20'000'000; time += 1000)
+            renderer.add_sample(time, stick_value(sample++));
+
+        measure("trail " + size_name(size), frames,
+                [&](unsigned)
+                {
+                    for (unsigned j = 0; j < 16; ++j, time += 1000)
+                        renderer.add_sample(time, stick_value(sample++));
+                    renderer.set_end_time(time);
+                    renderer.draw(cr, size.width, size.height);
+                });
+    }
+
+
+    // 16 positions per frame, along a slowly widening spiral.
+    void
+    bench_stick(const Size& size,
+                unsigned frames)
+    {
+        auto cr = make_context(size);
+
+        StickRenderer renderer{make_orig(0), make_orig(0)};
+        renderer.set_colors(make_colors());
+
+        std::vector<StickHeatmap::Point> points(16);
+        unsigned sample = 0;
+
+        measure("stick " + size_name(size), frames,
+                [&](unsigned i)
+                {
+                    const double radius = 32000.0 * (i % 2000) / 2000;
+                    for (auto& p : points) {
+                        const double angle = sample++ * 0.05;
+                        p.x = radius * std::cos(angle);
+                        p.y = radius * std::sin(angle);
+                    }
+                    renderer.add_points(points);
+                    renderer.draw(cr, size.width, size.height);
+                });
+    }
+
+
+    // A device with many axes, all of them moving every frame.
+    void
+    bench_overview(unsigned num_rows,
+                   double scale,
+                   unsigned frames)
+    {
+        const Size size{600, int(num_rows * OverviewRenderer::row_height), scale};
+        auto cr = make_context(size);
+
+        OverviewRenderer renderer;
+        renderer.set_colors(make_colors());
+        for (std::uint16_t code = 0; code < num_rows; ++code)
+            renderer.add_row(evdev::Code{code}, "ABS_" + std::to_string(code), make_orig(0));
+
+        measure("overview " + std::to_string(num_rows) + " rows " + size_name(size), frames,
+                [&](unsigned i)
+                {
+                    for (std::uint16_t code = 0; code < num_rows; ++code) {
+                        auto row = renderer.find_row(evdev::Code{code});
+                        row->calc.val = stick_value(i + code * 100);
+                        row->calc.min = std::min(row->calc.min, row->calc.val);
+                        row->calc.max = std::max(row->calc.max, row->calc.val);
+                    }
+                    renderer.draw(cr, size.width);
+                });
+    }
+
+} // namespace
+
+
+int
+main(int argc, char* argv[])
+try {
+    const unsigned frames = argc > 1 ? std::stoul(argv[1]) : 5'000;
+
+    print_header(frames);
+
+    const Size axis_sizes[] = {
+        { 300, 32, 1},
+        { 600, 48, 1},
+        {1200, 96, 1},
+        { 600, 48, 2},
+    };
+    for (auto& size : axis_sizes) {
+        bench_axis(size, frames, false, false, 256);
+        for (bool centered : {false, true})
+            for (int fuzz : {0, 256})
+                bench_axis(size, frames, true, centered, fuzz);
+    }
+    cout << endl;
+
+    const Size trail_sizes[] = {
+        { 300, 96, 1},
+        { 600, 96, 1},
+        {1200, 96, 1},
+        { 600, 96, 2},
+    };
+    for (auto& size : trail_sizes)
+        bench_trail(size, frames);
+    cout << endl;
+
+    const Size stick_sizes[] = {
+        {160, 160, 1},
+        {320, 320, 1},
+        {160, 160, 2},
+    };
+    for (auto& size : stick_sizes)
+        bench_stick(size, frames);
+    cout << endl;
+
+    for (unsigned num_rows : {16, 48})
+        bench_overview(num_rows, 1, frames);
+    bench_overview(48, 2, frames);
+}
+catch (std::exception& e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+}
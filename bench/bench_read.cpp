@@ -0,0 +1,195 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Compares how many events/second each backend can read from an evdev device.
+ *
+ * Usage: bench-read [FRAMES [AXES]]
+ *
+ * A synthetic joystick is created through uinput, so this must run with access to
+ * /dev/uinput (usually as root).
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <glib.h>
+#include <libevdevxx/Device.hpp>
+
+#include "uinput_device.hpp"
+
+#include "raw_reader.hpp"
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+using std::vector;
+
+using clock_type = std::chrono::steady_clock;
+
+
+namespace {
+
+    struct Result {
+        std::uint64_t events = 0;
+        std::uint64_t dropped = 0;
+        clock_type::duration elapsed{};
+    };
+
+
+    /*
+     * Emits frames in chunks small enough to fit the kernel's per-client buffer, and
+     * drains them after each chunk; only the draining is timed.
+     */
+    template<typename Drain>
+    Result
+    run(UInputDevice& udev,
+        unsigned num_axes,
+        std::uint64_t num_frames,
+        Drain drain)
+    {
+        const std::uint64_t frames_per_chunk = std::max(1u, 48 / (num_axes + 1));
+
+        Result result;
+        vector<input_event> chunk;
+        for (std::uint64_t frame = 0; frame < num_frames; frame += frames_per_chunk) {
+            chunk.clear();
+            for (std::uint64_t f = frame; f < std::min(num_frames, frame + frames_per_chunk); ++f) {
+                // The input core discards repeated values, so every frame changes.
+                const int value = static_cast<int>(f % 60000) - 30000;
+                for (unsigned code = 0; code < num_axes; ++code)
+                    chunk.push_back(input_event{{}, EV_ABS, static_cast<std::uint16_t>(code), value});
+                chunk.push_back(input_event{{}, EV_SYN, SYN_REPORT, 0});
+            }
+            udev.emit(chunk);
+
+            auto start = clock_type::now();
+            drain(result);
+            result.elapsed += clock_type::now() - start;
+        }
+        return result;
+    }
+
+
+    // Same loop as EvdevSource::handle_read().
+    Result
+    bench_libevdev(UInputDevice& udev,
+                   unsigned num_axes,
+                   std::uint64_t num_frames)
+    {
+        evdev::Device device{udev.get_path()};
+        vector<input_event> batch;
+
+        return run(udev, num_axes, num_frames,
+                   [&](Result& result)
+                   {
+                       const auto now = g_get_monotonic_time();
+                       batch.clear();
+                       while (device.has_pending()) {
+                           auto event = device.read();
+                           input_event raw{};
+                           raw.input_event_sec = now / G_USEC_PER_SEC;
+                           raw.input_event_usec = now % G_USEC_PER_SEC;
+                           raw.type = static_cast<std::uint16_t>(event.type);
+                           raw.code = event.code;
+                           raw.value = event.value;
+                           batch.push_back(raw);
+                       }
+                       result.events += batch.size();
+                   });
+    }
+
+
+    // Same loop as EvdevSource::handle_raw_read().
+    Result
+    bench_raw(UInputDevice& udev,
+              unsigned num_axes,
+              std::uint64_t num_frames)
+    {
+        int fd = open(udev.get_path().c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0)
+            throw std::system_error{errno, std::system_category(), udev.get_path().string()};
+        RawReader reader{fd};
+
+        Result result = run(udev, num_axes, num_frames,
+                            [&](Result& result)
+                            {
+                                for (;;) {
+                                    auto events = reader.read();
+                                    if (events.empty())
+                                        break;
+                                    for (auto& event : events)
+                                        if (event.type == EV_SYN && event.code == SYN_DROPPED)
+                                            ++result.dropped;
+                                    result.events += events.size();
+                                }
+                            });
+        close(fd);
+        return result;
+    }
+
+
+    void
+    report(const string& name,
+           const Result& result)
+    {
+        const double seconds = std::chrono::duration<double>(result.elapsed).count();
+        cout << std::left << std::setw(10) << name
+             << std::right << std::setw(12) << result.events
+             << std::setw(12) << std::fixed << std::setprecision(4) << seconds
+             << std::setw(16) << std::setprecision(0) << result.events / seconds;
+        if (result.dropped)
+            cout << "  (" << result.dropped << " SYN_DROPPED)";
+        cout << endl;
+    }
+
+} // namespace
+
+
+int
+main(int argc, char* argv[])
+try {
+    std::uint64_t num_frames = argc > 1 ? std::stoull(argv[1]) : 200'000;
+    unsigned num_axes = argc > 2 ? std::stoul(argv[2]) : 8;
+
+    UInputDevice udev{"calibrate-joystick benchmark", num_axes};
+
+    cout << num_frames << " frames of " << num_axes << " axes, from "
+         << udev.get_path().string() << "\n\n";
+    cout << std::left << std::setw(10) << "backend"
+         << std::right << std::setw(12) << "events"
+         << std::setw(12) << "seconds"
+         << std::setw(16) << "events/s" << endl;
+
+    auto lib = bench_libevdev(udev, num_axes, num_frames);
+    report("libevdev", lib);
+
+    auto raw = bench_raw(udev, num_axes, num_frames);
+    report("raw", raw);
+
+    cout << "\nraw/libevdev: " << std::setprecision(2)
+         << std::chrono::duration<double>(lib.elapsed).count() /
+            std::chrono::duration<double>(raw.elapsed).count()
+         << "x" << endl;
+}
+catch (std::exception& e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+}
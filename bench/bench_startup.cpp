@@ -0,0 +1,432 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Measures startup and hotplug latency of the application, with 1, 8, 32 and 64
+ * synthetic joysticks.
+ *
+ * Usage: bench-startup APP [AXES [RUNS [REPORT]]]
+ *
+ * For each number of devices, APP is launched RUNS times in GUI mode and in daemon
+ * mode (-d). The page cache is dropped before the first run of each case, so that one is
+ * a cold start; the others are warm starts. If the cache can't be dropped, all runs are
+ * reported as warm. Each run records:
+ *
+ *   - ready:     until the main window was painted (GUI), or until the daemon monitors
+ *                devices;
+ *   - all pages: until the pages of all devices were painted (GUI only);
+ *   - hotplug:   from creating one more device until its page was painted, as seen by
+ *                this program, and as reported by the application.
+ *
+ * The timings come from the application's debug messages (G_MESSAGES_DEBUG=all), timed
+ * on arrival. The results are written as JSON to REPORT (bench-startup.json by
+ * default).
+ *
+ * Needs access to /dev/uinput (usually root), a display, and no other instance of the
+ * application running.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "uinput_device.hpp"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::optional;
+using std::string;
+using std::vector;
+
+using clock_type = std::chrono::steady_clock;
+
+using namespace std::literals;
+
+
+namespace {
+
+    // How long to wait for each milestone, before giving up on the run.
+    constexpr auto milestone_timeout = 30s;
+
+
+    double
+    ms_since(clock_type::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(clock_type::now() - start).count();
+    }
+
+
+    // The application, with its output piped back to us, one line at a time.
+    class AppProcess {
+
+        pid_t pid = -1;
+        int fd = -1;
+        string buffer;
+
+    public:
+
+        clock_type::time_point start;
+
+
+        AppProcess(const string& app,
+                   bool daemon)
+        {
+            int fds[2];
+            if (pipe2(fds, O_CLOEXEC) < 0)
+                throw std::system_error{errno, std::system_category(), "pipe2()"};
+
+            start = clock_type::now();
+            pid = fork();
+            if (pid < 0)
+                throw std::system_error{errno, std::system_category(), "fork()"};
+
+            if (pid == 0) {
+                dup2(fds[1], STDOUT_FILENO);
+                dup2(fds[1], STDERR_FILENO);
+                if (daemon)
+                    execl(app.c_str(), app.c_str(), "-d", nullptr);
+                else
+                    execl(app.c_str(), app.c_str(), nullptr);
+                _exit(127);
+            }
+
+            close(fds[1]);
+            fd = fds[0];
+        }
+
+
+        ~AppProcess()
+            noexcept
+        {
+            kill(pid, SIGTERM);
+            // Drain the output, so the application doesn't block on a full pipe.
+            char buf[4096];
+            while (read(fd, buf, sizeof buf) > 0)
+                ;
+            waitpid(pid, nullptr, 0);
+            close(fd);
+        }
+
+
+        AppProcess(const AppProcess&) = delete;
+
+
+        // Returns the first line that matches, or nothing on a timeout.
+        optional<string>
+        wait_for(const std::function<bool(const string&)>& match)
+        {
+            const auto deadline = clock_type::now() + milestone_timeout;
+            for (;;) {
+                for (auto eol = buffer.find('\n'); eol != string::npos; eol = buffer.find('\n')) {
+                    string line = buffer.substr(0, eol);
+                    buffer.erase(0, eol + 1);
+                    if (match(line))
+                        return line;
+                }
+
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - clock_type::now());
+                if (left <= 0ms)
+                    return {};
+                pollfd pfd{fd, POLLIN, 0};
+                if (poll(&pfd, 1, left.count()) <= 0)
+                    continue;
+
+                char buf[4096];
+                auto r = read(fd, buf, sizeof buf);
+                if (r <= 0)
+                    return {}; // the application exited
+                buffer.append(buf, r);
+            }
+        }
+
+    }; // class AppProcess
+
+
+    // Parses the number that follows "after " in the application's trace messages.
+    optional<double>
+    parse_after(const string& line)
+    {
+        auto pos = line.find(" after ");
+        if (pos == string::npos)
+            return {};
+        try {
+            return std::stod(line.substr(pos + 7));
+        }
+        catch (std::exception&) {
+            return {};
+        }
+    }
+
+
+    bool
+    is_ready(const string& line,
+             bool daemon)
+    {
+        return line.find(daemon
+                         ? "Startup: daemon ready"
+                         : "Startup: main window shown") != string::npos;
+    }
+
+
+    // Matches the page of the named device, or of any device whose name starts with the
+    // prefix.
+    bool
+    is_page_visible(const string& line,
+                    const string& name_or_prefix)
+    {
+        auto pos = line.find(name_or_prefix);
+        if (pos == string::npos)
+            return false;
+        pos = line.find(" visible after ", pos + name_or_prefix.size());
+        return pos != string::npos;
+    }
+
+
+    struct Result {
+        string mode;
+        unsigned devices = 0;
+        unsigned run = 0;
+        bool cold = false;
+        optional<double> ready_ms;
+        optional<double> all_pages_ms;
+        optional<double> hotplug_ms;
+        optional<double> hotplug_app_ms;
+    };
+
+
+    const string device_prefix = "calibrate-joystick startup benchmark ";
+
+
+    string
+    device_name(unsigned i)
+    {
+        return device_prefix + std::to_string(i);
+    }
+
+
+    // Evicts the application, its libraries and its resources from the page cache.
+    bool
+    drop_caches()
+    {
+        sync();
+        std::ofstream out{"/proc/sys/vm/drop_caches"};
+        out << "3" << std::flush;
+        return static_cast<bool>(out);
+    }
+
+
+    Result
+    run_once(const string& app,
+             bool daemon,
+             unsigned num_devices,
+             unsigned num_axes,
+             unsigned run,
+             bool cold)
+    {
+        Result result;
+        result.mode = daemon ? "daemon" : "gui";
+        result.devices = num_devices;
+        result.run = run;
+        result.cold = cold;
+
+        AppProcess proc{app, daemon};
+
+        if (!proc.wait_for([daemon](const string& line) { return is_ready(line, daemon); }))
+            return result;
+        result.ready_ms = ms_since(proc.start);
+
+        // The daemon doesn't open devices that were already present.
+        if (!daemon) {
+            // Note: the pages show up in the order the devices finish opening.
+            for (unsigned i = 0; i < num_devices; ++i)
+                if (!proc.wait_for([](const string& line)
+                                   {
+                                       return is_page_visible(line, device_prefix);
+                                   }))
+                    return result;
+            result.all_pages_ms = ms_since(proc.start);
+        }
+
+        const auto hotplug_start = clock_type::now();
+        UInputDevice extra{device_name(num_devices), num_axes};
+        auto line = proc.wait_for([num_devices](const string& line)
+        {
+            return is_page_visible(line, device_name(num_devices));
+        });
+        if (line) {
+            result.hotplug_ms = ms_since(hotplug_start);
+            result.hotplug_app_ms = parse_after(*line);
+        }
+
+        return result;
+    }
+
+
+    string
+    format(const optional<double>& ms)
+    {
+        if (!ms)
+            return "-";
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << *ms;
+        return out.str();
+    }
+
+
+    string
+    to_json(const optional<double>& ms)
+    {
+        return ms ? format(ms) : "null";
+    }
+
+
+    void
+    print_header()
+    {
+        cout << std::left << std::setw(8) << "mode"
+             << std::right << std::setw(9) << "devices"
+             << std::setw(6) << "run"
+             << std::setw(12) << "ready ms"
+             << std::setw(14) << "all pages ms"
+             << std::setw(12) << "hotplug ms"
+             << std::setw(16) << "(app reports)" << endl;
+    }
+
+
+    void
+    print(const Result& r)
+    {
+        cout << std::left << std::setw(8) << r.mode
+             << std::right << std::setw(9) << r.devices
+             << std::setw(6) << (r.cold ? "cold" : std::to_string(r.run))
+             << std::setw(12) << format(r.ready_ms)
+             << std::setw(14) << format(r.all_pages_ms)
+             << std::setw(12) << format(r.hotplug_ms)
+             << std::setw(16) << format(r.hotplug_app_ms) << endl;
+    }
+
+
+    void
+    write_report(const string& filename,
+                 unsigned num_axes,
+                 const vector<Result>& results)
+    {
+        std::ofstream out{filename};
+        if (!out)
+            throw std::runtime_error{"Could not create " + filename};
+
+        out << "{\n";
+#ifdef PACKAGE_VERSION
+        out << "  \"version\": \"" << PACKAGE_VERSION << "\",\n";
+#endif
+        out << "  \"axes\": " << num_axes << ",\n";
+        out << "  \"results\": [\n";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << "    {"
+                << "\"mode\": \"" << r.mode << "\", "
+                << "\"devices\": " << r.devices << ", "
+                << "\"run\": " << r.run << ", "
+                << "\"cold\": " << (r.cold ? "true" : "false") << ", "
+                << "\"ready_ms\": " << to_json(r.ready_ms) << ", "
+                << "\"all_pages_ms\": " << to_json(r.all_pages_ms) << ", "
+                << "\"hotplug_ms\": " << to_json(r.hotplug_ms) << ", "
+                << "\"hotplug_app_ms\": " << to_json(r.hotplug_app_ms)
+                << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "  ]\n}\n";
+
+        if (!out.flush())
+            throw std::runtime_error{"Could not write to " + filename};
+    }
+
+} // namespace
+
+
+int
+main(int argc, char* argv[])
+try {
+    if (argc < 2) {
+        cerr << "Usage: " << argv[0] << " APP [AXES [RUNS [REPORT]]]" << endl;
+        return 2;
+    }
+    const string app = argv[1];
+    const unsigned num_axes = argc > 2 ? std::stoul(argv[2]) : 8;
+    const unsigned runs = argc > 3 ? std::stoul(argv[3]) : 3;
+    const string report = argc > 4 ? argv[4] : "bench-startup.json";
+
+    // Enables the application's trace messages.
+    setenv("G_MESSAGES_DEBUG", "all", 1);
+
+    cout << num_axes << " axes per device, " << runs << " runs per case\n\n";
+    print_header();
+
+    vector<Result> results;
+    bool failed = false;
+    bool can_drop_caches = true;
+
+    for (unsigned num_devices : {1, 8, 32, 64}) {
+        vector<std::unique_ptr<UInputDevice>> devices;
+        for (unsigned i = 0; i < num_devices; ++i)
+            devices.push_back(std::make_unique<UInputDevice>(device_name(i), num_axes));
+
+        for (bool daemon : {false, true})
+            for (unsigned run = 0; run < runs; ++run) {
+                bool cold = false;
+                if (run == 0 && can_drop_caches) {
+                    cold = drop_caches();
+                    if (!cold) {
+                        cerr << "Could not drop the page cache, all runs are warm." << endl;
+                        can_drop_caches = false;
+                    }
+                }
+                auto& r = results.emplace_back(run_once(app, daemon, num_devices, num_axes,
+                                                        run, cold));
+                print(r);
+                if (!r.ready_ms || !r.hotplug_ms || (!daemon && !r.all_pages_ms))
+                    failed = true;
+            }
+    }
+
+    write_report(report, num_axes, results);
+    cout << "\nReport written to " << report << endl;
+
+    if (failed) {
+        cerr << "Some milestones were not reached in time." << endl;
+        return 1;
+    }
+}
+catch (std::exception& e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+}
@@ -0,0 +1,208 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+/*
+ * Counts the canvas updates and change notifications caused by the AxisInfo
+ * operations.
+ *
+ * Usage: bench-update [RESOURCES]
+ *
+ * Drives real AxisInfo editors, with the widgets loaded from the resource bundle
+ * RESOURCES (calibrate-joystick.gresource by default). Every operation must flush the
+ * update batch exactly once (one canvas update, one notification), however many fields
+ * it touches. The operations that write to the spin buttons must also record a single
+ * change: otherwise the spin buttons fed their values back into calc. Exits with an
+ * error if any of this doesn't hold. Without a display, the checks are skipped.
+ */
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtkmm.h>
+
+#include <linux/input.h>
+
+#include "axis_info.hpp"
+#include "colors.hpp"
+#include "update_batch.hpp"
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::string;
+
+using evdev::AbsInfo;
+
+
+namespace {
+
+    AbsInfo
+    make_info(int i)
+    {
+        AbsInfo info;
+        info.val = i;
+        info.min = -1000 - i;
+        info.max = 1000 + i;
+        info.fuzz = 16 + i;
+        info.flat = 128 + i;
+        info.res = 1 + i;
+        return info;
+    }
+
+
+    Colors
+    make_colors()
+    {
+        Colors c;
+        c.background.set_rgba(0.1, 0.1, 0.1);
+        c.value.set_rgba(1.0, 1.0, 1.0);
+        c.min.set_rgba(0.3, 0.6, 1.0);
+        c.max.set_rgba(1.0, 0.4, 0.3);
+        c.fuzz.set_rgba(0.8, 0.8, 0.2);
+        c.flat.set_rgba(0.4, 0.9, 0.4);
+        return c;
+    }
+
+
+    bool failed = false;
+
+
+    void
+    print_header()
+    {
+        cout << std::left << std::setw(24) << "operation"
+             << std::right << std::setw(12) << "changes"
+             << std::setw(16) << "canvas updates"
+             << std::setw(16) << "notifications" << endl;
+    }
+
+
+    /*
+     * Runs op(axis, i) on a fresh editor, and checks the counters per operation. If
+     * expected_changes is given, each operation must record exactly that many changes.
+     */
+    void
+    run_case(const string& name,
+             std::optional<std::uint64_t> expected_changes,
+             const std::function<void(AxisInfo&, int)>& op)
+    {
+        AxisInfo axis{evdev::Code{ABS_X}, make_info(0)};
+
+        std::uint64_t notifications = 0;
+        axis.signal_changed().connect([&notifications] { ++notifications; });
+
+        const auto& batch = axis.get_update_batch();
+        const auto changes_before = batch.get_changes();
+        const auto flushes_before = batch.get_flushes();
+
+        const unsigned runs = 100;
+        for (unsigned i = 1; i <= runs; ++i)
+            op(axis, i);
+
+        const auto changes = batch.get_changes() - changes_before;
+        const auto flushes = batch.get_flushes() - flushes_before;
+
+        cout << std::left << std::setw(24) << name
+             << std::right << std::fixed << std::setprecision(2)
+             << std::setw(12) << double(changes) / runs
+             << std::setw(16) << double(flushes) / runs
+             << std::setw(16) << double(notifications) / runs << endl;
+
+        if (flushes != runs || notifications != runs) {
+            cerr << name << ": expected one canvas update and one notification per operation"
+                 << endl;
+            failed = true;
+        }
+        if (expected_changes && changes != *expected_changes * runs) {
+            cerr << name << ": expected " << *expected_changes
+                 << " change(s) per operation; the spin buttons fed back into calc" << endl;
+            failed = true;
+        }
+    }
+
+} // namespace
+
+
+int
+main(int argc, char* argv[])
+try {
+    const string res_path = argc > 1 ? argv[1] : "calibrate-joystick.gresource";
+
+    if (!gtk_init_check(&argc, &argv)) {
+        cout << "No display, skipping the AxisInfo checks." << endl;
+        return 0;
+    }
+    // Note: this also initializes the gtkmm wrappers.
+    auto app = Gtk::Application::create("com.github.dkosmari.CalibrateJoystick.BenchUpdate",
+                                        Gio::ApplicationFlags::APPLICATION_NON_UNIQUE);
+
+    auto resource = Gio::Resource::create_from_file(res_path);
+    resource->register_global();
+
+    {
+        // The constructor resets the editor to the device's AbsInfo.
+        AxisInfo axis{evdev::Code{ABS_X}, make_info(0)};
+        const auto& batch = axis.get_update_batch();
+        if (batch.get_flushes() != 1 || batch.get_changes() != 1) {
+            cerr << "constructor: expected one change and one canvas update" << endl;
+            failed = true;
+        }
+    }
+
+    print_header();
+
+    run_case("restore session", 1,
+             [](AxisInfo& axis, int i)
+             {
+                 axis.set_calc(make_info(i));
+             });
+
+    run_case("reset", 1,
+             [](AxisInfo& axis, int i)
+             {
+                 axis.reset(make_info(i));
+             });
+
+    // What DevicePage::create_axis() does, when switching editors in overview mode.
+    const auto colors = make_colors();
+    run_case("create editor", 1,
+             [&colors](AxisInfo& axis, int i)
+             {
+                 axis.begin_update();
+                 axis.set_calc(make_info(i));
+                 axis.set_flat_centered(i % 2);
+                 axis.set_colors(colors);
+                 axis.commit_update();
+             });
+
+    // A page flush after many reports: every value lands, but is drawn once.
+    run_case("device reports", {},
+             [](AxisInfo& axis, int i)
+             {
+                 axis.begin_update();
+                 for (int j = 0; j < 16; ++j)
+                     axis.set_calc_value(i * 16 + j, -i * 16 - j, i * 16 + j);
+                 axis.commit_update();
+             });
+
+    return failed ? 1 : 0;
+}
+catch (Glib::Error& e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+}
+catch (std::exception& e) {
+    cerr << "Error: " << e.what() << endl;
+    return 1;
+}
@@ -0,0 +1,143 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <linux/uinput.h>
+
+#include "uinput_device.hpp"
+
+
+using std::filesystem::path;
+using std::runtime_error;
+using std::string;
+
+using namespace std::literals;
+
+
+namespace {
+
+    [[noreturn]]
+    void
+    throw_errno(const char* what)
+    {
+        throw std::system_error{errno, std::system_category(), what};
+    }
+
+
+    // Locates the event node the kernel created for the uinput device.
+    path
+    find_event_node(int fd)
+    {
+        char sysname[64] = {};
+        if (ioctl(fd, UI_GET_SYSNAME(sizeof sysname - 1), sysname) < 0)
+            throw_errno("UI_GET_SYSNAME");
+
+        const path sys_path = path{"/sys/devices/virtual/input"} / sysname;
+
+        // Wait for udev to create the node, and apply its permissions.
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            std::error_code ec;
+            for (auto& entry : std::filesystem::directory_iterator{sys_path, ec}) {
+                auto name = entry.path().filename().string();
+                if (!name.starts_with("event"))
+                    continue;
+                path dev_path = path{"/dev/input"} / name;
+                if (access(dev_path.c_str(), R_OK) == 0)
+                    return dev_path;
+            }
+            std::this_thread::sleep_for(10ms);
+        }
+        throw runtime_error{"Could not find event node for " + sys_path.string()};
+    }
+
+} // namespace
+
+
+UInputDevice::UInputDevice(const string& name,
+                           unsigned num_axes)
+{
+    if (num_axes == 0 || num_axes > ABS_MISC)
+        throw runtime_error{"Invalid number of axes."};
+
+    fd = open("/dev/uinput", O_WRONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw_errno("/dev/uinput");
+
+    try {
+        if (ioctl(fd, UI_SET_EVBIT, EV_ABS) < 0)
+            throw_errno("UI_SET_EVBIT");
+
+        // Without a joystick button, udev might not tag it with ID_INPUT_JOYSTICK.
+        if (ioctl(fd, UI_SET_EVBIT, EV_KEY) < 0)
+            throw_errno("UI_SET_EVBIT");
+        if (ioctl(fd, UI_SET_KEYBIT, BTN_TRIGGER) < 0)
+            throw_errno("UI_SET_KEYBIT");
+
+        for (unsigned code = 0; code < num_axes; ++code) {
+            uinput_abs_setup abs{};
+            abs.code = code;
+            abs.absinfo.minimum = -32768;
+            abs.absinfo.maximum = 32767;
+            if (ioctl(fd, UI_SET_ABSBIT, code) < 0)
+                throw_errno("UI_SET_ABSBIT");
+            if (ioctl(fd, UI_ABS_SETUP, &abs) < 0)
+                throw_errno("UI_ABS_SETUP");
+        }
+
+        uinput_setup setup{};
+        setup.id.bustype = BUS_VIRTUAL;
+        setup.id.vendor = 0x1209; // pid.codes test VID
+        setup.id.product = 0x0001;
+        std::strncpy(setup.name, name.c_str(), UINPUT_MAX_NAME_SIZE - 1);
+        if (ioctl(fd, UI_DEV_SETUP, &setup) < 0)
+            throw_errno("UI_DEV_SETUP");
+
+        if (ioctl(fd, UI_DEV_CREATE) < 0)
+            throw_errno("UI_DEV_CREATE");
+
+        dev_path = find_event_node(fd);
+    }
+    catch (...) {
+        close(fd);
+        throw;
+    }
+}
+
+
+UInputDevice::~UInputDevice()
+    noexcept
+{
+    ioctl(fd, UI_DEV_DESTROY);
+    close(fd);
+}
+
+
+const path&
+UInputDevice::get_path()
+    const noexcept
+{
+    return dev_path;
+}
+
+
+void
+UInputDevice::emit(std::span<const input_event> events)
+{
+    const auto size = events.size_bytes();
+    if (write(fd, events.data(), size) != static_cast<ssize_t>(size))
+        throw_errno("write()");
+}
@@ -0,0 +1,51 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef UINPUT_DEVICE_HPP
+#define UINPUT_DEVICE_HPP
+
+#include <filesystem>
+#include <span>
+#include <string>
+
+#include <linux/input.h>
+
+
+/*
+ * A synthetic joystick, created through /dev/uinput, for benchmarks.
+ *
+ * Needs write access to /dev/uinput, and read access to the created event device.
+ */
+class UInputDevice {
+
+    int fd = -1;
+
+    std::filesystem::path dev_path;
+
+public:
+
+    UInputDevice(const std::string& name,
+                 unsigned num_axes);
+
+    ~UInputDevice()
+        noexcept;
+
+    UInputDevice(const UInputDevice&) = delete;
+
+
+    // The /dev/input/event* node of this device.
+    const std::filesystem::path&
+    get_path()
+        const noexcept;
+
+
+    void
+    emit(std::span<const input_event> events);
+
+}; // class UInputDevice
+
+#endif
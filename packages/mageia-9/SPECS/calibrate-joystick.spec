@@ -35,6 +35,7 @@ stick around, and apply the calculated minimum and maximum range.
 %license COPYING
 %doc README.md
 %{_bindir}/calibrate-joystick
+%{_bindir}/calibrate-joystick-daemon
 %{_datadir}/calibrate-joystick/*.gresource
 %{_datadir}/applications/*.desktop
 %{_datadir}/glib-2.0/schemas/*.gschema.xml
@@ -18,6 +18,10 @@
 
 #include "controller_db.hpp"
 #include "device_page.hpp"
+#include "evdev_source.hpp"
+#include "probe_pool.hpp"
+#include "redraw_scheduler.hpp"
+#include "replay_source.hpp"
 #include "utils.hpp"
 #include "settings.hpp"
 
@@ -58,6 +62,20 @@ namespace {
     const string application_glade = RESOURCE_PREFIX "/ui/application.glade";
 
 
+    // Reference point for the startup trace.
+    const std::int64_t process_start = g_get_monotonic_time();
+
+
+    // Startup milestones, shown with G_MESSAGES_DEBUG=all.
+    void
+    trace_startup(const char* stage)
+    {
+        g_debug("Startup: %s after %.1f ms.",
+                stage,
+                (g_get_monotonic_time() - process_start) / 1000.0);
+    }
+
+
 #ifdef G_OS_UNIX
 
     gboolean
@@ -100,7 +118,15 @@ App::load_widgets()
     if (main_window)
         return;
 
-    auto builder = Gtk::Builder::create_from_resource(application_glade);
+    // Note: the dialogs are only built when first used.
+    auto builder = Gtk::Builder::create_from_resource(application_glade,
+                                                      {
+                                                          "main_window",
+                                                          "header_bar",
+                                                          "quit_icon",
+                                                          "refresh_icon",
+                                                          "settings_icon",
+                                                      });
 
     utils::get_widget(builder, "main_window", main_window);
 
@@ -123,18 +149,120 @@ App::load_widgets()
         });
     }
 
-    utils::get_widget(builder, "about_dialog", about_dialog);
-    about_dialog->set_program_name(PACKAGE_NAME);
-    about_dialog->set_website(PACKAGE_URL);
-    about_dialog->set_version(PACKAGE_VERSION);
-    about_dialog->add_button(_("_Close"), Gtk::ResponseType::RESPONSE_CLOSE);
 
-    utils::get_widget_derived(builder, "settings_window", settings_window);
+    trace_startup("main window created");
+}
+
 
-    utils::get_widget<Gtk::Dialog>(builder, "delete_dialog", delete_dialog);
-    delete_dialog->add_button(_("_Cancel"), Gtk::RESPONSE_CANCEL);
-    delete_dialog->add_button(_("_Delete"), Gtk::RESPONSE_ACCEPT);
-    delete_dialog->set_default_response(Gtk::RESPONSE_ACCEPT);
+Gtk::AboutDialog&
+App::get_about_dialog()
+{
+    if (!about_dialog) {
+        auto builder = Gtk::Builder::create_from_resource(application_glade,
+                                                          "about_dialog");
+        utils::get_widget(builder, "about_dialog", about_dialog);
+        about_dialog->set_transient_for(*main_window);
+        about_dialog->set_program_name(PACKAGE_NAME);
+        about_dialog->set_website(PACKAGE_URL);
+        about_dialog->set_version(PACKAGE_VERSION);
+        about_dialog->add_button(_("_Close"), Gtk::ResponseType::RESPONSE_CLOSE);
+    }
+    return *about_dialog;
+}
+
+
+Settings&
+App::get_settings_window()
+{
+    if (!settings_window) {
+        auto builder = Gtk::Builder::create_from_resource(application_glade,
+                                                          {
+                                                              "settings_window",
+                                                              "close_icon",
+                                                              "reset_icon",
+                                                          });
+        utils::get_widget_derived(builder, "settings_window", settings_window);
+        settings_window->set_transient_for(*main_window);
+    }
+    return *settings_window;
+}
+
+
+Gtk::Dialog&
+App::get_delete_dialog()
+{
+    if (!delete_dialog) {
+        auto builder = Gtk::Builder::create_from_resource(application_glade,
+                                                          "delete_dialog");
+        utils::get_widget<Gtk::Dialog>(builder, "delete_dialog", delete_dialog);
+        delete_dialog->set_transient_for(*main_window);
+        delete_dialog->add_button(_("_Cancel"), Gtk::RESPONSE_CANCEL);
+        delete_dialog->add_button(_("_Delete"), Gtk::RESPONSE_ACCEPT);
+        delete_dialog->set_default_response(Gtk::RESPONSE_ACCEPT);
+    }
+    return *delete_dialog;
+}
+
+
+void
+App::load_settings()
+{
+    settings = Gio::Settings::create(APPLICATION_ID);
+    settings->signal_changed().connect(sigc::mem_fun(this, &App::on_setting_changed));
+
+#if GLIB_CHECK_VERSION(2, 70, 0)
+    power_monitor = Glib::wrap(G_OBJECT(g_power_profile_monitor_dup_default()));
+    if (power_monitor)
+        power_monitor->connect_property_changed("power-saver-enabled",
+                                                sigc::mem_fun(this, &App::update_max_fps));
+#endif
+
+    update_max_fps();
+    load_colors();
+}
+
+
+void
+App::on_setting_changed(const ustring& key)
+{
+    if (key == "max-fps" || key == "power-saver-max-fps")
+        update_max_fps();
+    else if (key == "hide-idle-axes") {
+        for (auto& [_, page] : devices)
+            page->set_idle_timeout(settings->get_uint(key));
+    } else if (key.raw().ends_with("-color"))
+        load_colors();
+}
+
+
+void
+App::load_colors()
+{
+    colors.background = Gdk::RGBA{settings->get_string("background-color")};
+    colors.value      = Gdk::RGBA{settings->get_string("value-color")};
+    colors.min        = Gdk::RGBA{settings->get_string("min-color")};
+    colors.max        = Gdk::RGBA{settings->get_string("max-color")};
+    colors.fuzz       = Gdk::RGBA{settings->get_string("fuzz-color")};
+    colors.flat       = Gdk::RGBA{settings->get_string("flat-color")};
+    on_colors_changed();
+}
+
+
+void
+App::update_max_fps()
+{
+    unsigned fps = settings->get_uint("max-fps");
+
+#if GLIB_CHECK_VERSION(2, 70, 0)
+    auto monitor = power_monitor ? G_POWER_PROFILE_MONITOR(power_monitor->gobj()) : nullptr;
+    if (monitor && g_power_profile_monitor_get_power_saver_enabled(monitor)) {
+        unsigned saver_fps = settings->get_uint("power-saver-max-fps");
+        if (saver_fps && (!fps || saver_fps < fps))
+            fps = saver_fps;
+    }
+#endif
+
+    RedrawScheduler::get().set_max_fps(fps);
 }
 
 
@@ -158,6 +286,7 @@ App::present_main_window()
 {
     TRACE;
 
+    load_widgets();
     add_window(*main_window);
     main_window->present();
 }
@@ -192,9 +321,10 @@ App::send_daemon_notification()
 void
 App::on_action_about()
 {
-    add_window(*about_dialog);
-    about_dialog->run();
-    about_dialog->hide();
+    auto& dialog = get_about_dialog();
+    add_window(dialog);
+    dialog.run();
+    dialog.hide();
 }
 
 
@@ -272,8 +402,9 @@ App::on_action_refresh()
 void
 App::on_action_settings()
 {
-    add_window(*settings_window);
-    settings_window->present();
+    auto& window = get_settings_window();
+    add_window(window);
+    window.present();
 }
 
 
@@ -291,14 +422,15 @@ try {
     path_label.set_ellipsize(Pango::EllipsizeMode::ELLIPSIZE_START);
     path_label.show();
 
-    auto box = delete_dialog->get_content_area();
+    auto& dialog = get_delete_dialog();
+    auto box = dialog.get_content_area();
     box->pack_start(path_label, true, true);
 
-    if (delete_dialog->run() == Gtk::ResponseType::RESPONSE_ACCEPT) {
+    if (dialog.run() == Gtk::ResponseType::RESPONSE_ACCEPT) {
         cout << "Deleting " << config_file << endl;
         remove(config_file);
     }
-    delete_dialog->hide();
+    dialog.hide();
 }
 catch (std::exception& e) {
     cerr << "Error: " << e.what() << endl;
@@ -318,6 +450,7 @@ App::on_startup()
 #endif
 
     create_actions();
+    load_settings();
 
     if (opt_daemon) {
         //cout << "running as daemon" << endl;
@@ -334,6 +467,8 @@ App::on_startup()
         // if no status icon is available, send a notification instead
         if (!status_icon->is_embedded())
             send_daemon_notification();
+
+        trace_startup("daemon ready");
     }
 }
 
@@ -345,14 +480,27 @@ App::on_activate()
 
     Gtk::Application::on_activate();
 
-    load_widgets();
-
+    // The daemon only creates the window when there's something to show.
     if (opt_daemon && silent_start) {
         silent_start = false;
         return;
     }
 
     present_main_window();
+
+    // Drawing has a higher priority than idle handlers, so this runs after the window
+    // was painted.
+    if (!startup_traced) {
+        startup_traced = true;
+        Glib::signal_idle().connect_once([] { trace_startup("main window shown"); });
+    }
+
+    if (!replay_file.empty()) {
+        clear_devices();
+        add_replay(replay_file);
+        return;
+    }
+
     on_action_refresh();
 }
 
@@ -363,8 +511,6 @@ App::on_open(const type_vec_files& files,
 {
     TRACE;
 
-    load_widgets();
-
     Gtk::Application::on_open(files, hint);
 
     silent_start = false;
@@ -398,6 +544,20 @@ App::on_handle_local_options(const RefPtr<Glib::VariantDict>& options)
         opt_daemon = true;
     }
 
+    if (ustring mode_name; options->lookup_value("reader", mode_name)) {
+        auto mode = parse_read_mode(mode_name.raw());
+        if (!mode) {
+            cerr << _("Invalid reader mode: ") << mode_name << endl;
+            return 1;
+        }
+        read_mode = *mode;
+    }
+
+    if (std::string filename; options->lookup_value("replay", filename))
+        replay_file = filename;
+
+    options->lookup_value("replay-speed", replay_speed);
+
     return -1;
 }
 
@@ -437,7 +597,9 @@ App::on_colors_changed()
 App::App() :
     Gtk::Application{APPLICATION_ID, app_flags}
 {
-    ControllerDB::initialize();
+    probe_pool = make_unique<ProbePool>([this](DeviceProbe& probe) { on_probe_done(probe); });
+
+    // Note: ControllerDB loads the database when it's first used.
 
     signal_handle_local_options()
         .connect(sigc::mem_fun(this, &App::on_handle_local_options));
@@ -450,9 +612,26 @@ App::App() :
                           "daemon", 'd',
                           _("Run in daemon mode."));
 
+    add_main_option_entry(OptionType::OPTION_TYPE_STRING,
+                          "reader", 'r',
+                          _("How to read devices: \"libevdev\" (default), \"raw\" or \"thread\"."),
+                          _("MODE"));
+
+    add_main_option_entry(OptionType::OPTION_TYPE_FILENAME,
+                          "replay", '\0',
+                          _("Replay a capture file instead of reading devices."),
+                          _("FILE"));
+
+    add_main_option_entry(OptionType::OPTION_TYPE_DOUBLE,
+                          "replay-speed", '\0',
+                          _("Replay speed multiplier; 0 replays as fast as possible."),
+                          _("N"));
+
     if (!load_resources(PACKAGE ".gresource") &&
         !load_resources(RESOURCES_DIR "/" PACKAGE ".gresource"))
         throw std::runtime_error{_("Could not load resources file.")};
+
+    trace_startup("application constructed");
 }
 
 
@@ -466,6 +645,8 @@ void
 App::clear_devices()
 {
     devices.clear();
+    // Results of pending probes will be ignored.
+    probing.clear();
 }
 
 
@@ -474,18 +655,91 @@ App::add_device(const path& dev_path)
 {
     TRACE;
 
+    if (devices.contains(dev_path) || probing.contains(dev_path))
+        return;
+
+    // Opening can be slow, so it's done in the background; see on_probe_done().
+    const auto token = ++next_probe_token;
+    probing.emplace(dev_path, ProbeRequest{token, g_get_monotonic_time()});
+    probe_pool->submit(dev_path, token);
+}
+
+
+void
+App::on_probe_done(DeviceProbe& probe)
+{
+    TRACE;
+
+    // The device was removed, or the list was refreshed, while it was being opened.
+    // If it was added again, a newer probe is pending: this one holds the old fd.
+    auto request = probing.find(probe.dev_path);
+    if (request == probing.end() || request->second.token != probe.token)
+        return;
+    const auto start_time = request->second.start_time;
+    probing.erase(request);
+
+    auto key = probe.dev_path;
+    add_page(key,
+             [this, &probe]
+             {
+                 return make_unique<EvdevSource>(std::move(probe), read_mode, reactor);
+             },
+             start_time);
+}
+
+
+void
+App::add_replay(const path& cap_path)
+{
+    TRACE;
+
+    add_page(cap_path,
+             [this, &cap_path]
+             {
+                 return make_unique<ReplaySource>(cap_path, replay_speed);
+             },
+             g_get_monotonic_time());
+}
+
+
+void
+App::add_page(const path& key,
+              const std::function<std::unique_ptr<InputSource>()>& create_source,
+              std::int64_t start_time)
+{
     try {
+        if (devices.contains(key))
+            return;
+
+        const auto page_start = g_get_monotonic_time();
         auto [iter, inserted] =
-            devices.emplace(dev_path, make_unique<DevicePage>(dev_path));
+            devices.emplace(key, make_unique<DevicePage>(create_source()));
         if (!inserted)
             return;
 
         auto& page = iter->second;
+        load_widgets();
         device_notebook->append_page(page->root(), page->get_name());
         page->set_colors(colors);
+        page->set_idle_timeout(settings->get_uint("hide-idle-axes"));
+
+        // Drawing has a higher priority than idle handlers, so this runs after the
+        // window was laid out and painted with the new page.
+        const auto page_end = g_get_monotonic_time();
+        Glib::signal_idle().connect_once([name = page->get_name(),
+                                          start_time, page_start, page_end]
+        {
+            const auto now = g_get_monotonic_time();
+            g_debug("%s visible after %.1f ms (open: %.1f ms, page: %.1f ms, paint: %.1f ms).",
+                    name.c_str(),
+                    (now - start_time) / 1000.0,
+                    (page_start - start_time) / 1000.0,
+                    (page_end - page_start) / 1000.0,
+                    (now - page_end) / 1000.0);
+        });
     }
     catch (std::exception& e) {
-        cerr << "Error in App::add_device(): " << e.what() << endl;
+        cerr << "Error in App::add_page(): " << e.what() << endl;
         present_main_window();
         Gtk::MessageDialog dialog{
             *main_window,
@@ -498,7 +752,7 @@ App::add_device(const path& dev_path)
     }
 
     // Only pop up the main window if there's no config for this device.
-    if (!devices.at(dev_path)->has_loaded_config())
+    if (!devices.at(key)->has_loaded_config())
         present_main_window();
 }
 
@@ -506,58 +760,11 @@ App::add_device(const path& dev_path)
 void
 App::remove_device(const path& dev_path)
 {
+    probing.erase(dev_path);
     devices.erase(dev_path);
 }
 
 
-void
-App::set_background_color(const Gdk::RGBA& color)
-{
-    colors.background = color;
-    on_colors_changed();
-}
-
-
-void
-App::set_value_color(const Gdk::RGBA& color)
-{
-    colors.value = color;
-    on_colors_changed();
-}
-
-
-void
-App::set_min_color(const Gdk::RGBA& color)
-{
-    colors.min = color;
-    on_colors_changed();
-}
-
-
-void
-App::set_max_color(const Gdk::RGBA& color)
-{
-    colors.max = color;
-    on_colors_changed();
-}
-
-
-void
-App::set_fuzz_color(const Gdk::RGBA& color)
-{
-    colors.fuzz = color;
-    on_colors_changed();
-}
-
-
-void
-App::set_flat_color(const Gdk::RGBA& color)
-{
-    colors.flat = color;
-    on_colors_changed();
-}
-
-
 RefPtr<App>
 App::get_default()
 {
@@ -8,7 +8,9 @@
 #ifndef APP_HPP
 #define APP_HPP
 
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
@@ -18,9 +20,14 @@
 #include <gudevxx/Client.hpp>
 
 #include "colors.hpp"
+#include "reactor.hpp"
+#include "read_mode.hpp"
 
 
 class DevicePage;
+class InputSource;
+class ProbePool;
+struct DeviceProbe;
 class Settings;
 
 
@@ -30,32 +37,82 @@ class App : public Gtk::Application {
 
     std::unique_ptr<Gtk::ApplicationWindow> main_window;
     std::unique_ptr<Gtk::HeaderBar> header_bar;
+    // Note: created on first use.
     std::unique_ptr<Gtk::AboutDialog> about_dialog;
     std::unique_ptr<Settings> settings_window;
     std::unique_ptr<Gtk::Dialog> delete_dialog;
 
+    Glib::RefPtr<Gio::Settings> settings;
+    // The GPowerProfileMonitor, if available.
+    Glib::RefPtr<Glib::Object> power_monitor;
+
     Gtk::Notebook* device_notebook = nullptr;
     Gtk::Button* quit_button = nullptr;
 
+    // Watches the fds of all devices; must outlive them.
+    Reactor reactor;
+
     std::map<std::filesystem::path,
              std::unique_ptr<DevicePage>> devices;
 
+    // Opens devices in the background.
+    std::unique_ptr<ProbePool> probe_pool;
+    // Devices being opened in the background.
+    struct ProbeRequest {
+        // Only the result with this token is used; older ones are stale.
+        std::uint64_t token;
+        // When the device was requested.
+        std::int64_t start_time;
+    };
+    std::map<std::filesystem::path, ProbeRequest> probing;
+    std::uint64_t next_probe_token = 0;
+
     gudev::Client uclient = nullptr;
 
     Glib::RefPtr<Gtk::StatusIcon> status_icon;
 
     bool opt_daemon = false;
     bool silent_start = false;
+    ReadMode read_mode = ReadMode::libevdev;
+
+    std::filesystem::path replay_file;
+    double replay_speed = 1.0;
 
     Colors colors;
 
+    bool startup_traced = false;
+
 
     bool
     load_resources(const std::filesystem::path& res_path);
 
+    // Creates the main window, if it wasn't created yet.
     void
     load_widgets();
 
+    Gtk::AboutDialog&
+    get_about_dialog();
+
+    Settings&
+    get_settings_window();
+
+    Gtk::Dialog&
+    get_delete_dialog();
+
+
+    void
+    load_settings();
+
+    void
+    on_setting_changed(const Glib::ustring& key);
+
+    void
+    load_colors();
+
+    void
+    update_max_fps();
+
+
     void
     create_actions();
 
@@ -113,6 +170,17 @@ class App : public Gtk::Application {
     void
     on_colors_changed();
 
+
+    void
+    on_probe_done(DeviceProbe& probe);
+
+
+    // The start time is when the page was requested, to report how long it took to show.
+    void
+    add_page(const std::filesystem::path& key,
+             const std::function<std::unique_ptr<InputSource>()>& create_source,
+             std::int64_t start_time);
+
 public:
 
     App();
@@ -129,24 +197,8 @@ public:
     void
     remove_device(const std::filesystem::path& dev_path);
 
-
-    void
-    set_background_color(const Gdk::RGBA& color);
-
-    void
-    set_value_color(const Gdk::RGBA& color);
-
-    void
-    set_min_color(const Gdk::RGBA& color);
-
-    void
-    set_max_color(const Gdk::RGBA& color);
-
-    void
-    set_fuzz_color(const Gdk::RGBA& color);
-
     void
-    set_flat_color(const Gdk::RGBA& color);
+    add_replay(const std::filesystem::path& cap_path);
 
 
     static
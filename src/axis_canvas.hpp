@@ -13,30 +13,32 @@
 
 #include <libevdevxx/AbsInfo.hpp>
 
+#include "axis_renderer.hpp"
 #include "colors.hpp"
 
 
 class AxisCanvas : public Gtk::DrawingArea {
 
-    evdev::AbsInfo orig;
-    evdev::AbsInfo calc;
-    bool flat_centered;
-    int orig_fuzz_center;
-    int calc_fuzz_center;
-
-    Colors colors;
+    AxisRenderer renderer;
 
 
     bool
     on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
         override;
 
+    // Redraws on the next frame, through the RedrawScheduler.
+    void
+    schedule_draw();
+
 public:
 
     AxisCanvas(BaseObjectType* cobject,
                const Glib::RefPtr<Gtk::Builder>& /* builder */,
                const evdev::AbsInfo& orig);
 
+    ~AxisCanvas()
+        noexcept override;
+
 
     void
     reset(const evdev::AbsInfo& new_orig,
@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: GPL-3.0-or-later
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include <iostream>
@@ -12,6 +13,7 @@
 #include "axis_info.hpp"
 
 #include "axis_canvas.hpp"
+#include "trail_canvas.hpp"
 #include "utils.hpp"
 
 #ifdef HAVE_CONFIG_H
@@ -34,6 +36,9 @@ namespace {
 
     const string axis_info_glade = RESOURCE_PREFIX "/ui/axis-info.glade";
 
+    // Minimum time between text refreshes, in microseconds.
+    constexpr std::int64_t refresh_interval = 100'000;
+
 } // namespace
 
 
@@ -49,6 +54,44 @@ AxisInfo::AxisInfo(evdev::Code axis_code,
 }
 
 
+AxisInfo::~AxisInfo()
+    noexcept
+{
+    refresh_conn.disconnect();
+}
+
+
+void
+AxisInfo::begin_update()
+    noexcept
+{
+    batch.begin();
+}
+
+
+void
+AxisInfo::commit_update()
+{
+    batch.commit();
+}
+
+
+sigc::signal<void>&
+AxisInfo::signal_changed()
+    noexcept
+{
+    return changed_signal;
+}
+
+
+const UpdateBatch&
+AxisInfo::get_update_batch()
+    const noexcept
+{
+    return batch;
+}
+
+
 void
 AxisInfo::create_actions()
 {
@@ -60,6 +103,9 @@ AxisInfo::create_actions()
 
     action_revert = actions->add_action("revert",
                                         sigc::mem_fun(this, &AxisInfo::on_action_revert));
+
+    action_trail = actions->add_action_bool("trail",
+                                            sigc::mem_fun(this, &AxisInfo::on_action_trail));
 }
 
 
@@ -86,19 +132,24 @@ AxisInfo::load_widgets()
     builder->get_widget("calc_flat_spin", calc_flat_spin);
     builder->get_widget("calc_res_spin",  calc_res_spin);
 
-    calc_min_spin->signal_value_changed()
-        .connect([this] { set_calc_min(calc_min_spin->get_value_as_int()); });
-    calc_max_spin->signal_value_changed()
-        .connect([this] { set_calc_max(calc_max_spin->get_value_as_int()); });
-    calc_fuzz_spin->signal_value_changed()
-        .connect([this] { set_calc_fuzz(calc_fuzz_spin->get_value_as_int()); });
-    calc_flat_spin->signal_value_changed()
-        .connect([this] { set_calc_flat(calc_flat_spin->get_value_as_int()); });
-    calc_res_spin->signal_value_changed()
-        .connect([this] { set_calc_res(calc_res_spin->get_value_as_int()); });
+    // Only edits made by the user are fed back into calc.
+    auto connect_spin = [this](Gtk::SpinButton* spin,
+                               void (AxisInfo::*setter)(int))
+    {
+        spin->signal_value_changed().connect([this, spin, setter]
+        {
+            if (!updating_widgets)
+                (this->*setter)(spin->get_value_as_int());
+        });
+    };
+    connect_spin(calc_min_spin,  &AxisInfo::set_calc_min);
+    connect_spin(calc_max_spin,  &AxisInfo::set_calc_max);
+    connect_spin(calc_fuzz_spin, &AxisInfo::set_calc_fuzz);
+    connect_spin(calc_flat_spin, &AxisInfo::set_calc_flat);
+    connect_spin(calc_res_spin,  &AxisInfo::set_calc_res);
 
     builder->get_widget_derived("axis_canvas", axis_canvas, orig);
-    update_canvas();
+    builder->get_widget_derived("trail_canvas", trail_canvas);
 
     builder->get_widget("flat_item_zero", flat_item_zero);
     builder->get_widget("flat_item_centered", flat_item_centered);
@@ -120,27 +171,114 @@ AxisInfo::root()
 void
 AxisInfo::update_canvas()
 {
-    if (axis_canvas)
-        axis_canvas->update(calc);
+    if (axis_canvas) {
+        if (orig_changed)
+            axis_canvas->reset(orig, calc);
+        else
+            axis_canvas->update(calc);
+    }
+    orig_changed = false;
+    // The trail also shows values outside the original range.
+    if (trail_canvas)
+        trail_canvas->set_range(std::min(orig.min, calc.min),
+                                std::max(orig.max, calc.max));
 }
 
 
 void
-AxisInfo::set_calc_value(int value)
+AxisInfo::flush_update()
 {
-    value_label->set_label(ustring::format(value));
+    update_canvas();
+    changed_signal.emit();
+}
 
-    if (value < calc.min)
-        calc.min = value;
-    if (value > calc.max)
-        calc.max = value;
 
-    calc_min_spin->set_value(calc.min);
-    calc_max_spin->set_value(calc.max);
+void
+AxisInfo::set_spin(Gtk::SpinButton* spin,
+                   int value)
+{
+    // Note: setting a spin button always reformats its text, even for the same value.
+    if (spin->get_value_as_int() == value)
+        return;
+    updating_widgets = true;
+    spin->set_value(value);
+    updating_widgets = false;
+}
 
+
+void
+AxisInfo::set_calc_value(int value)
+{
+    set_calc_value(value, value, value);
+}
+
+
+void
+AxisInfo::set_calc_value(int value,
+                         int low,
+                         int high)
+{
+    // The numbers are always exact; only their display is delayed.
+    if (low < calc.min)
+        calc.min = low;
+    if (high > calc.max)
+        calc.max = high;
     calc.val = value;
 
-    update_canvas();
+    batch.changed();
+    queue_refresh();
+}
+
+
+void
+AxisInfo::queue_refresh()
+{
+    if (refresh_conn.connected())
+        return;
+
+    const auto wait = last_refresh + refresh_interval - g_get_monotonic_time();
+    if (wait <= 0) {
+        refresh_widgets();
+        return;
+    }
+
+    refresh_conn = Glib::signal_timeout().connect([this]
+    {
+        refresh_widgets();
+        return false;
+    },
+    wait / 1000 + 1);
+}
+
+
+void
+AxisInfo::refresh_widgets()
+{
+    refresh_conn.disconnect();
+    last_refresh = g_get_monotonic_time();
+
+    if (shown_value != calc.val) {
+        value_label->set_label(ustring::format(calc.val));
+        shown_value = calc.val;
+    }
+
+    set_spin(calc_min_spin, calc.min);
+    set_spin(calc_max_spin, calc.max);
+}
+
+
+void
+AxisInfo::add_sample(std::int64_t time,
+                     int value)
+{
+    trail_canvas->add_sample(time, value);
+}
+
+
+void
+AxisInfo::set_trail_time(std::int64_t time)
+{
+    trail_canvas->set_end_time(time);
 }
 
 
@@ -148,7 +286,7 @@ void
 AxisInfo::set_calc_min(int min)
 {
     calc.min = min;
-    update_canvas();
+    batch.changed();
 }
 
 
@@ -156,7 +294,7 @@ void
 AxisInfo::set_calc_max(int max)
 {
     calc.max = max;
-    update_canvas();
+    batch.changed();
 }
 
 
@@ -164,7 +302,7 @@ void
 AxisInfo::set_calc_fuzz(int fuzz)
 {
     calc.fuzz = fuzz;
-    update_canvas();
+    batch.changed();
 }
 
 
@@ -172,7 +310,7 @@ void
 AxisInfo::set_calc_flat(int flat)
 {
     calc.flat = flat;
-    update_canvas();
+    batch.changed();
 }
 
 
@@ -180,7 +318,7 @@ void
 AxisInfo::set_calc_res(int res)
 {
     calc.res = res;
-    update_canvas();
+    batch.changed();
 }
 
 
@@ -200,6 +338,17 @@ AxisInfo::on_action_revert()
 }
 
 
+void
+AxisInfo::on_action_trail()
+{
+    bool enabled = false;
+    action_trail->get_state(enabled);
+    enabled = !enabled;
+    action_trail->change_state(enabled);
+    trail_canvas->set_enabled(enabled);
+}
+
+
 void
 AxisInfo::on_changed_flat_to_zero()
 {
@@ -229,9 +378,25 @@ AxisInfo::get_calc() const noexcept
 }
 
 
+void
+AxisInfo::set_calc(const AbsInfo& new_calc)
+{
+    UpdateBatch::Guard guard{batch};
+
+    calc = new_calc;
+    set_spin(calc_fuzz_spin, calc.fuzz);
+    set_spin(calc_flat_spin, calc.flat);
+    set_spin(calc_res_spin,  calc.res);
+    refresh_widgets();
+    batch.changed();
+}
+
+
 void
 AxisInfo::reset(const AbsInfo& new_orig)
 {
+    UpdateBatch::Guard guard{batch};
+
     calc = orig = new_orig;
     calc.min = calc.max = orig.val;
 
@@ -241,14 +406,18 @@ AxisInfo::reset(const AbsInfo& new_orig)
     orig_flat_label->set_label(ustring::format(orig.flat));
     orig_res_label ->set_label(ustring::format(orig.res));
 
-    calc_fuzz_spin->set_value(calc.fuzz);
-    calc_flat_spin->set_value(calc.flat);
-    calc_res_spin ->set_value(calc.res);
+    set_spin(calc_fuzz_spin, calc.fuzz);
+    set_spin(calc_flat_spin, calc.flat);
+    set_spin(calc_res_spin,  calc.res);
 
-    set_calc_value(calc.val);
+    value_label->set_label(ustring::format(calc.val));
+    shown_value = calc.val;
+    refresh_widgets();
+    orig_changed = true;
+    batch.changed();
 
-    if (axis_canvas)
-        axis_canvas->reset(orig, calc);
+    if (trail_canvas)
+        trail_canvas->clear();
 }
 
 
@@ -269,8 +438,9 @@ AxisInfo::disable()
 void
 AxisInfo::set_colors(const Colors& c)
 {
+    // Note: calc didn't change, so there's nothing to notify.
     axis_canvas->set_colors(c);
-    update_canvas();
+    trail_canvas->set_colors(c);
 }
 
 
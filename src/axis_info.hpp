@@ -8,6 +8,7 @@
 #ifndef AXIS_INFO_HPP
 #define AXIS_INFO_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -16,9 +17,11 @@
 #include <libevdevxx/Event.hpp>
 
 #include "colors.hpp"
+#include "update_batch.hpp"
 
 
 class AxisCanvas;
+class TrailCanvas;
 
 
 class AxisInfo {
@@ -28,6 +31,7 @@ class AxisInfo {
     Glib::RefPtr<Gio::SimpleAction> action_revert;
     Glib::RefPtr<Gio::SimpleAction> action_flat_zero;
     Glib::RefPtr<Gio::SimpleAction> action_flat_centered;
+    Glib::RefPtr<Gio::SimpleAction> action_trail;
 
     std::unique_ptr<Gtk::Frame> info_frame;
 
@@ -50,6 +54,7 @@ class AxisInfo {
     Gtk::RadioMenuItem* flat_item_centered = nullptr;
 
     AxisCanvas* axis_canvas = nullptr;
+    TrailCanvas* trail_canvas = nullptr;
 
     evdev::Code code;
     evdev::AbsInfo orig;
@@ -57,6 +62,21 @@ class AxisInfo {
 
     bool flat_centered = false;
 
+    // The text widgets lag behind calc, and are refreshed at a bounded rate.
+    int shown_value = 0;
+    std::int64_t last_refresh = 0;
+    sigc::connection refresh_conn;
+
+    // Changes to calc are coalesced into one canvas update and one notification.
+    UpdateBatch batch{[this] { flush_update(); }};
+    // Set by reset(), so the next flush also gives the canvas the new orig.
+    bool orig_changed = false;
+    sigc::signal<void> changed_signal;
+
+    // Set while the program writes to the spin buttons, so their value_changed
+    // signals are not fed back into calc.
+    bool updating_widgets = false;
+
 
     void
     create_actions();
@@ -67,6 +87,21 @@ class AxisInfo {
     void
     update_canvas();
 
+    void
+    flush_update();
+
+    void
+    set_spin(Gtk::SpinButton* spin,
+             int value);
+
+    // Refresh the text widgets now, or as soon as the rate allows.
+    void
+    queue_refresh();
+
+    // Show calc in the text widgets, touching only the ones that changed.
+    void
+    refresh_widgets();
+
     void
     set_calc_min(int min);
 
@@ -89,6 +124,9 @@ class AxisInfo {
     void
     on_action_revert();
 
+    void
+    on_action_trail();
+
 
     void
     on_changed_flat_to_zero();
@@ -104,9 +142,46 @@ public:
     AxisInfo(evdev::Code axis_code,
              const evdev::AbsInfo& info);
 
+    ~AxisInfo()
+        noexcept;
+
+
+    // Changes made between these only update the canvas and notify once.
+    void
+    begin_update()
+        noexcept;
+
+    void
+    commit_update();
+
+    // Emitted once for every batch of changes to calc (or every change, outside of a batch).
+    sigc::signal<void>&
+    signal_changed()
+        noexcept;
+
+    const UpdateBatch&
+    get_update_batch()
+        const noexcept;
+
+
     void
     set_calc_value(int value);
 
+    // Set the value, and extend calc min/max to also cover [low, high].
+    void
+    set_calc_value(int value,
+                   int low,
+                   int high);
+
+    // Feed the trail plot; does nothing unless the trail is enabled.
+    void
+    add_sample(std::int64_t time,
+               int value);
+
+    // Scroll the trail plot to the latest report time.
+    void
+    set_trail_time(std::int64_t time);
+
     Gtk::Widget&
     root();
 
@@ -114,6 +189,10 @@ public:
     get_calc()
         const noexcept;
 
+    // Replace all calc parameters, e.g. to restore a previous editing session.
+    void
+    set_calc(const evdev::AbsInfo& new_calc);
+
     void
     reset(const evdev::AbsInfo& new_orig);
 
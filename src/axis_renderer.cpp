@@ -0,0 +1,417 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <cairo.h>
+
+#include "axis_renderer.hpp"
+
+
+using evdev::AbsInfo;
+
+
+namespace {
+
+    // RAII class to call save/restore on the context.
+    struct CtxGuard {
+
+        const Cairo::RefPtr<Cairo::Context>& ctx;
+
+        CtxGuard(const Cairo::RefPtr<Cairo::Context>& ctx_) :
+            ctx(ctx_)
+        {
+            ctx->save();
+        }
+
+        ~CtxGuard()
+            noexcept
+        {
+            ctx->restore();
+        }
+
+    };
+
+
+    void
+    set_color(const Cairo::RefPtr<Cairo::Context>& ctx,
+              const Gdk::RGBA& color)
+    {
+        ctx->set_source_rgba(color.get_red(),
+                             color.get_green(),
+                             color.get_blue(),
+                             color.get_alpha());
+    }
+
+
+    const std::vector<double> calc_dash{2.0, 2.0};
+    const std::vector<double> fuzz_dash{1.5, 1.5};
+
+    const double padding = 18.5;
+
+
+    double
+    device_scale(const Cairo::RefPtr<Cairo::Context>& cr)
+    {
+        double sx = 1, sy = 1;
+        cairo_surface_get_device_scale(cr->get_target()->cobj(), &sx, &sy);
+        return sx;
+    }
+
+
+    int
+    update_fuzz_center(int center,
+                       int fuzz,
+                       int value)
+    {
+        /*
+         * Note: the kernel's defuzzing does this:
+         *
+         * Assume:
+         * - real_value: the real value read from the axis this instant.
+         * - user_value: the last value sent to userspace.
+         * - delta = real_value - user_value
+         * Then:
+         * - if -fuzz/2 < delta < +fuzz/2: do not change user_value
+         * - if -fuzz < delta < +fuzz: user_value = lerp(user_value, real_value, 0.25)
+         * - if -2*fuzz < delta < +2*fuzz: user_value = lerp(user_value, real_value, 0.5)
+         * - otherwise: user_value = real_value
+         *
+         * (The freedesktop folks hate this; libinput always forces the fuzz to zero, and
+         * applies its own defuzzing).
+         *
+         * The code below corresponds to the first case, to show the region where the
+         * value doesn't change at all. The real value change must be at least twice the
+         * value of fuzz, in order to be free from kernel defuzzing.
+         */
+        int half_fuzz = fuzz / 2;
+        int min = center - half_fuzz;
+        int max = center + half_fuzz;
+        if (value < min)
+            center = value + half_fuzz;
+        if (value > max)
+            center = value - half_fuzz;
+        return center;
+    }
+
+} // namespace
+
+
+AxisRenderer::AxisRenderer(const AbsInfo& orig) :
+    orig{orig},
+    calc{orig},
+    orig_fuzz_center{orig.val},
+    calc_fuzz_center{orig.val}
+{}
+
+
+double
+AxisRenderer::to_canvas(double x,
+                        double width)
+    const noexcept
+{
+    double orig_range = orig.max - orig.min;
+    if (orig_range < 1)
+        orig_range = 1;
+
+    // transform values within [orig.min, orig.max] to [padding, width-padding]
+    return padding + std::round((x - orig.min) * double(width - 2 * padding) / orig_range);
+}
+
+
+void
+AxisRenderer::draw_static(const Cairo::RefPtr<Cairo::Context>& cr,
+                          double width,
+                          double height)
+    const
+{
+    set_color(cr, colors.background);
+    cr->rectangle(0, 0, width, height);
+    cr->fill();
+
+    {
+        // draw orig min-max
+        const double h = 10.5;
+        const double w = 6.5;
+        const double left = to_canvas(orig.min, width);
+        const double right = to_canvas(orig.max, width);
+
+        CtxGuard guard{cr};
+
+        cr->translate(0, height / 2.0);
+
+        cr->set_line_width(3.0);
+
+        // min
+        set_color(cr, colors.min);
+        cr->move_to(left + w, -h);
+        cr->line_to(left, -h);
+        cr->line_to(left, +h);
+        cr->line_to(left + w, +h);
+        cr->stroke();
+
+        // max
+        set_color(cr, colors.max);
+        cr->move_to(right - w, -h);
+        cr->line_to(right, -h);
+        cr->line_to(right, +h);
+        cr->line_to(right - w, +h);
+        cr->stroke();
+
+    }
+
+    {
+        // draw calc min-max
+        const double r = 9.5;
+        const double left = to_canvas(calc.min, width);
+        const double right = to_canvas(calc.max, width);
+
+        CtxGuard guard{cr};
+
+        cr->translate(0, height / 2.0);
+
+        cr->set_line_width(1.5);
+        cr->set_dash(calc_dash, 0);
+
+        // calc min
+        set_color(cr, colors.min);
+        cr->arc(left + r, 0, r, M_PI/2, 3*M_PI/2);
+        cr->stroke();
+
+        // calc max
+        set_color(cr, colors.max);
+        cr->arc(right - r, 0, r, 3*M_PI/2, M_PI/2);
+        cr->stroke();
+    }
+
+    {
+        // draw box representing orig.flat
+        const double flat_height = 19;
+        const double flat_anchor = flat_centered ? (orig.min + orig.max) / 2.0 : 0.0;
+        const double flat_left   = to_canvas(flat_anchor - orig.flat, width);
+        const double flat_right  = to_canvas(flat_anchor + orig.flat, width);
+        const double flat_width  = flat_right - flat_left;
+
+        CtxGuard guard{cr};
+
+        cr->set_line_width(3.0);
+        set_color(cr, colors.flat);
+        cr->rectangle(flat_left, (height - flat_height)/2.0,
+                      flat_width, flat_height);
+        cr->stroke();
+    }
+
+    {
+        // draw calc flat
+        const double r = 6.5;
+        const double flat_anchor = flat_centered ? (calc.min + calc.max) / 2.0 : 0.0;
+        const double flat_left   = to_canvas(flat_anchor - calc.flat, width);
+        const double flat_right  = to_canvas(flat_anchor + calc.flat, width);
+
+        CtxGuard guard{cr};
+
+        cr->translate(0, height / 2.0);
+        cr->set_line_width(1.0);
+        cr->set_dash(calc_dash, 0.0);
+        set_color(cr, colors.flat);
+        cr->arc(flat_left  + r, 0, r,   M_PI/2, 3*M_PI/2);
+        cr->arc(flat_right - r, 0, r, 3*M_PI/2,   M_PI/2);
+        cr->close_path();
+        cr->stroke();
+    }
+}
+
+
+void
+AxisRenderer::draw_dynamic(const Cairo::RefPtr<Cairo::Context>& cr,
+                           double width,
+                           double height)
+    const
+{
+    const double fuzz_size = 6.5;
+    if (orig.fuzz) {
+        // "<>" markers for orig fuzz
+        const double half_fuzz_width = to_canvas(orig.fuzz/2, width) - to_canvas(0, width);
+        const double half_fuzz_height = fuzz_size;
+        const double fuzz_center = to_canvas(orig_fuzz_center, width);
+        CtxGuard guard{cr};
+        set_color(cr, colors.fuzz);
+        cr->set_line_width(2.0);
+        cr->translate(0, height / 2.0);
+        // left
+        cr->move_to(fuzz_center - half_fuzz_width, 0);
+        cr->line_to(fuzz_center - half_fuzz_width + half_fuzz_height, -half_fuzz_height);
+        cr->move_to(fuzz_center - half_fuzz_width, 0);
+        cr->line_to(fuzz_center - half_fuzz_width + half_fuzz_height, +half_fuzz_height);
+        cr->stroke();
+        // right
+        cr->move_to(fuzz_center + half_fuzz_width, 0);
+        cr->line_to(fuzz_center + half_fuzz_width - half_fuzz_height, -half_fuzz_height);
+        cr->move_to(fuzz_center + half_fuzz_width, 0);
+        cr->line_to(fuzz_center + half_fuzz_width - half_fuzz_height, +half_fuzz_height);
+        cr->stroke();
+    }
+
+    if (calc.fuzz) {
+        // "<>" markers for calc fuzz
+        const double half_fuzz_width = to_canvas(calc.fuzz/2, width) - to_canvas(0, width);
+        const double half_fuzz_height = fuzz_size;
+        const double fuzz_center = to_canvas(calc_fuzz_center, width);
+        CtxGuard guard{cr};
+        set_color(cr, colors.fuzz);
+        cr->set_line_width(1.5);
+        cr->set_dash(fuzz_dash, 0.0);
+        cr->translate(0, height / 2.0);
+        // left
+        cr->move_to(fuzz_center - half_fuzz_width, 0);
+        cr->line_to(fuzz_center - half_fuzz_width + half_fuzz_height, -half_fuzz_height);
+        cr->move_to(fuzz_center - half_fuzz_width, 0);
+        cr->line_to(fuzz_center - half_fuzz_width + half_fuzz_height, +half_fuzz_height);
+        cr->stroke();
+        // right
+        cr->move_to(fuzz_center + half_fuzz_width, 0);
+        cr->line_to(fuzz_center + half_fuzz_width - half_fuzz_height, -half_fuzz_height);
+        cr->move_to(fuzz_center + half_fuzz_width, 0);
+        cr->line_to(fuzz_center + half_fuzz_width - half_fuzz_height, +half_fuzz_height);
+        cr->stroke();
+    }
+
+    {
+        // draw value marker as a cross
+        const double marker_radius = 4.5;
+        CtxGuard guard{cr};
+        set_color(cr, colors.value);
+        cr->set_line_width(1.5);
+        cr->translate(to_canvas(calc.val, width), height / 2.0);
+        cr->move_to(-marker_radius, 0);
+        cr->line_to(+marker_radius, 0);
+        cr->move_to(0, -marker_radius);
+        cr->line_to(0, +marker_radius);
+        cr->stroke();
+    }
+}
+
+
+void
+AxisRenderer::reset(const AbsInfo& new_orig,
+                    const AbsInfo& new_calc)
+{
+    orig = new_orig;
+    update(new_calc);
+    orig_fuzz_center = orig.val;
+    calc_fuzz_center = orig.val;
+    static_dirty = true;
+}
+
+
+void
+AxisRenderer::update(const AbsInfo& new_calc)
+{
+    // Only the value and fuzz are drawn dynamically.
+    if (new_calc.min != calc.min
+        || new_calc.max != calc.max
+        || new_calc.flat != calc.flat)
+        static_dirty = true;
+
+    calc = new_calc;
+
+    // calculate fuzz centers
+    int value = calc.val;
+
+    orig_fuzz_center = update_fuzz_center(orig_fuzz_center, orig.fuzz, value);
+    calc_fuzz_center = update_fuzz_center(calc_fuzz_center, calc.fuzz, value);
+}
+
+
+void
+AxisRenderer::set_flat_centered(bool is_centered)
+{
+    if (flat_centered != is_centered)
+        static_dirty = true;
+    flat_centered = is_centered;
+}
+
+
+const Colors&
+AxisRenderer::get_colors()
+    const noexcept
+{
+    return colors;
+}
+
+
+void
+AxisRenderer::set_colors(const Colors& c)
+{
+    colors = c;
+    static_dirty = true;
+}
+
+
+void
+AxisRenderer::draw(const Cairo::RefPtr<Cairo::Context>& cr,
+                   double width,
+                   double height)
+{
+    const double scale = device_scale(cr);
+
+    if (!static_layer
+        || static_dirty
+        || width != static_width
+        || height != static_height
+        || scale != static_scale) {
+
+        // Note: the similar surface inherits the device scale of the target.
+        if (!static_layer
+            || width != static_width
+            || height != static_height
+            || scale != static_scale)
+            static_layer = Cairo::Surface::create(cr->get_target(),
+                                                  Cairo::CONTENT_COLOR_ALPHA,
+                                                  std::ceil(width),
+                                                  std::ceil(height));
+
+        auto layer_cr = Cairo::Context::create(static_layer);
+        layer_cr->set_operator(Cairo::OPERATOR_CLEAR);
+        layer_cr->paint();
+        layer_cr->set_operator(Cairo::OPERATOR_OVER);
+        draw_static(layer_cr, width, height);
+        static_width = width;
+        static_height = height;
+        static_scale = scale;
+        static_dirty = false;
+        ++static_renders;
+    }
+
+    {
+        CtxGuard guard{cr};
+        cr->set_source(static_layer, 0, 0);
+        cr->paint();
+    }
+
+    draw_dynamic(cr, width, height);
+}
+
+
+void
+AxisRenderer::draw_uncached(const Cairo::RefPtr<Cairo::Context>& cr,
+                            double width,
+                            double height)
+    const
+{
+    draw_static(cr, width, height);
+    draw_dynamic(cr, width, height);
+}
+
+
+std::uint64_t
+AxisRenderer::get_static_renders()
+    const noexcept
+{
+    return static_renders;
+}
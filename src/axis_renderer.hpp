@@ -0,0 +1,110 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef AXIS_RENDERER_HPP
+#define AXIS_RENDERER_HPP
+
+#include <cstdint>
+
+#include <cairomm/cairomm.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+
+#include "colors.hpp"
+
+
+/*
+ * Draws one axis: the orig and calc limits, flat and fuzz, and the current value.
+ *
+ * The layers that only change during calibration (background, limits and flat) are
+ * rendered once into a cached surface; each frame only composites that surface and
+ * draws the fuzz and value markers on top.
+ */
+class AxisRenderer {
+
+    evdev::AbsInfo orig;
+    evdev::AbsInfo calc;
+    bool flat_centered = false;
+    int orig_fuzz_center;
+    int calc_fuzz_center;
+
+    Colors colors;
+
+    // Cache of the static layers.
+    Cairo::RefPtr<Cairo::Surface> static_layer;
+    double static_width = 0;
+    double static_height = 0;
+    double static_scale = 0;
+    bool static_dirty = true;
+
+    std::uint64_t static_renders = 0;
+
+
+    double
+    to_canvas(double x,
+              double width)
+        const noexcept;
+
+    void
+    draw_static(const Cairo::RefPtr<Cairo::Context>& cr,
+                double width,
+                double height)
+        const;
+
+    void
+    draw_dynamic(const Cairo::RefPtr<Cairo::Context>& cr,
+                 double width,
+                 double height)
+        const;
+
+public:
+
+    explicit
+    AxisRenderer(const evdev::AbsInfo& orig);
+
+
+    void
+    reset(const evdev::AbsInfo& new_orig,
+          const evdev::AbsInfo& new_calc);
+
+    void
+    update(const evdev::AbsInfo& new_calc);
+
+    void
+    set_flat_centered(bool is_centered);
+
+
+    const Colors&
+    get_colors()
+        const noexcept;
+
+    void
+    set_colors(const Colors& c);
+
+
+    // Draws using the cached static layers, re-rendering them if needed.
+    void
+    draw(const Cairo::RefPtr<Cairo::Context>& cr,
+         double width,
+         double height);
+
+    // Draws every layer directly, without the cache.
+    void
+    draw_uncached(const Cairo::RefPtr<Cairo::Context>& cr,
+                  double width,
+                  double height)
+        const;
+
+
+    // How many times the static layers were rendered.
+    std::uint64_t
+    get_static_renders()
+        const noexcept;
+
+}; // class AxisRenderer
+
+#endif
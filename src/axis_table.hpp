@@ -0,0 +1,266 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef AXIS_TABLE_HPP
+#define AXIS_TABLE_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <linux/input.h>
+
+#include <libevdevxx/Code.hpp>
+
+
+/*
+ * Per-axis storage, indexed directly by the ABS_* code.
+ *
+ * Lookups are a single indexed load; a presence mask keeps track of which codes were
+ * inserted, and iteration visits only those, in increasing code order, like a std::map
+ * would. Codes outside of [0, ABS_CNT) are never present.
+ */
+template<typename T>
+class AxisTable {
+
+public:
+
+    using value_type = std::pair<const evdev::Code, T>;
+
+private:
+
+    static_assert(ABS_CNT <= 64, "presence mask must fit in 64 bits");
+
+    std::array<value_type, ABS_CNT> slots;
+
+    std::uint64_t present = 0;
+
+
+    template<std::size_t... I>
+    static
+    std::array<value_type, ABS_CNT>
+    make_slots(std::index_sequence<I...>)
+    {
+        return {{ value_type{evdev::Code{static_cast<std::uint16_t>(I)}, T{}}... }};
+    }
+
+
+    template<bool Const>
+    class basic_iterator {
+
+        using Table = std::conditional_t<Const, const AxisTable, AxisTable>;
+
+        Table* table = nullptr;
+        std::uint64_t mask = 0;
+
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = AxisTable::value_type;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+
+        basic_iterator() noexcept = default;
+
+        basic_iterator(Table* table,
+                       std::uint64_t mask)
+            noexcept :
+            table{table},
+            mask{mask}
+        {}
+
+
+        reference
+        operator *()
+            const noexcept
+        {
+            return table->slots[std::countr_zero(mask)];
+        }
+
+
+        pointer
+        operator ->()
+            const noexcept
+        {
+            return &**this;
+        }
+
+
+        basic_iterator&
+        operator ++()
+            noexcept
+        {
+            mask &= mask - 1;
+            return *this;
+        }
+
+
+        basic_iterator
+        operator ++(int)
+            noexcept
+        {
+            auto old = *this;
+            ++*this;
+            return old;
+        }
+
+
+        bool
+        operator ==(const basic_iterator& other)
+            const noexcept
+        {
+            return mask == other.mask;
+        }
+
+    }; // class basic_iterator
+
+public:
+
+    using iterator = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+
+    AxisTable() :
+        slots{make_slots(std::make_index_sequence<ABS_CNT>{})}
+    {}
+
+    AxisTable(const AxisTable& other) = default;
+
+    AxisTable(AxisTable&& other) = default;
+
+
+    // Note: the codes are const, so only the values are assigned.
+    AxisTable&
+    operator =(const AxisTable& other)
+    {
+        for (std::size_t i = 0; i < slots.size(); ++i)
+            slots[i].second = other.slots[i].second;
+        present = other.present;
+        return *this;
+    }
+
+
+    AxisTable&
+    operator =(AxisTable&& other)
+        noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        for (std::size_t i = 0; i < slots.size(); ++i)
+            slots[i].second = std::move(other.slots[i].second);
+        present = other.present;
+        return *this;
+    }
+
+
+    bool
+    contains(unsigned code)
+        const noexcept
+    {
+        return code < ABS_CNT && (present >> code & 1);
+    }
+
+
+    // Returns nullptr if the code is not present.
+    T*
+    find(unsigned code)
+        noexcept
+    {
+        return contains(code) ? &slots[code].second : nullptr;
+    }
+
+    const T*
+    find(unsigned code)
+        const noexcept
+    {
+        return contains(code) ? &slots[code].second : nullptr;
+    }
+
+
+    // Inserts the code if it's not present. Throws std::out_of_range for invalid codes.
+    T&
+    operator [](unsigned code)
+    {
+        if (code >= ABS_CNT)
+            throw std::out_of_range{"invalid axis code " + std::to_string(code)};
+        present |= std::uint64_t{1} << code;
+        return slots[code].second;
+    }
+
+
+    void
+    erase(unsigned code)
+    {
+        if (!contains(code))
+            return;
+        slots[code].second = T{};
+        present &= ~(std::uint64_t{1} << code);
+    }
+
+
+    void
+    clear()
+    {
+        for (auto& [code, value] : *this)
+            value = T{};
+        present = 0;
+    }
+
+
+    std::size_t
+    size()
+        const noexcept
+    {
+        return std::popcount(present);
+    }
+
+
+    bool
+    empty()
+        const noexcept
+    {
+        return !present;
+    }
+
+
+    iterator
+    begin()
+        noexcept
+    {
+        return {this, present};
+    }
+
+    iterator
+    end()
+        noexcept
+    {
+        return {this, 0};
+    }
+
+    const_iterator
+    begin()
+        const noexcept
+    {
+        return {this, present};
+    }
+
+    const_iterator
+    end()
+        const noexcept
+    {
+        return {this, 0};
+    }
+
+}; // class AxisTable
+
+#endif
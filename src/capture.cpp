@@ -0,0 +1,334 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+#include "capture.hpp"
+
+
+using std::cerr;
+using std::endl;
+using std::filesystem::path;
+using std::runtime_error;
+using std::string;
+
+using namespace std::literals;
+
+
+namespace Capture {
+
+    namespace {
+
+        const char magic[6] = { 'C', 'J', 'C', 'A', 'P', '\0' };
+
+        constexpr std::uint8_t format_version = 1;
+
+        // How long the writer thread waits, to accumulate events into a larger batch.
+        constexpr auto batch_interval = 100ms;
+
+
+        void
+        put_varint(string& out,
+                   std::uint64_t v)
+        {
+            while (v >= 0x80) {
+                out.push_back(static_cast<char>((v & 0x7f) | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+
+        void
+        put_signed(string& out,
+                   std::int64_t v)
+        {
+            // zigzag encoding: small magnitudes become small unsigned numbers
+            put_varint(out, (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+        }
+
+    } // namespace
+
+
+    std::int64_t
+    event_time(const input_event& event)
+        noexcept
+    {
+        return std::int64_t{event.input_event_sec} * 1'000'000 + event.input_event_usec;
+    }
+
+
+    Writer::Writer(const path& filename,
+                   const Header& header) :
+        file{filename, std::ios::binary | std::ios::trunc}
+    {
+        if (!file)
+            throw runtime_error{"Could not create " + filename.string()};
+
+        string buf{magic, sizeof magic};
+        buf.push_back(static_cast<char>(format_version));
+
+        put_signed(buf, header.clock);
+        put_varint(buf, header.vendor);
+        put_varint(buf, header.product);
+        put_varint(buf, header.version);
+        put_varint(buf, header.name.size());
+        buf += header.name;
+
+        put_varint(buf, header.axes.size());
+        for (const auto& [code, info] : header.axes) {
+            put_varint(buf, code);
+            put_signed(buf, info.val);
+            put_signed(buf, info.min);
+            put_signed(buf, info.max);
+            put_signed(buf, info.fuzz);
+            put_signed(buf, info.flat);
+            put_signed(buf, info.res);
+            if (code < ABS_CNT)
+                last_abs[code] = info.val;
+        }
+
+        if (!file.write(buf.data(), buf.size()))
+            throw runtime_error{"Could not write to " + filename.string()};
+
+        thread = std::thread{&Writer::run, this};
+    }
+
+
+    Writer::~Writer()
+        noexcept
+    {
+        try {
+            submit();
+        }
+        catch (std::exception& e) {
+            cerr << "Failed to submit last capture events: " << e.what() << endl;
+        }
+
+        {
+            std::lock_guard guard{mutex};
+            stopping = true;
+        }
+        cond.notify_all();
+
+        if (thread.joinable())
+            thread.join();
+    }
+
+
+    void
+    Writer::run()
+        noexcept
+    {
+        std::vector<input_event> batch;
+
+        std::unique_lock lock{mutex};
+        for (;;) {
+            cond.wait(lock, [this] { return stopping || !queue.empty(); });
+            std::swap(batch, queue);
+            const bool stop = stopping;
+            lock.unlock();
+
+            if (!failed) {
+                try {
+                    write_batch(batch);
+                }
+                catch (std::exception& e) {
+                    cerr << "Failed to write capture: " << e.what() << endl;
+                    failed = true;
+                }
+            }
+            batch.clear();
+
+            if (stop)
+                return;
+
+            lock.lock();
+            cond.wait_for(lock, batch_interval, [this] { return stopping; });
+        }
+    }
+
+
+    void
+    Writer::write_batch(const std::vector<input_event>& batch)
+    {
+        if (batch.empty())
+            return;
+
+        string buf;
+        buf.reserve(batch.size() * 4);
+
+        for (const auto& event : batch) {
+            const std::int64_t t = event_time(event);
+            put_signed(buf, t - last_time);
+            last_time = t;
+
+            put_varint(buf, (std::uint32_t{event.code} << 5) | event.type);
+
+            if (event.type == EV_ABS && event.code < ABS_CNT) {
+                put_signed(buf, std::int64_t{event.value} - last_abs[event.code]);
+                last_abs[event.code] = event.value;
+            } else
+                put_signed(buf, event.value);
+        }
+
+        if (!file.write(buf.data(), buf.size()) || !file.flush())
+            throw runtime_error{"I/O error."};
+    }
+
+
+    void
+    Writer::add(const input_event& event)
+    {
+        staged.push_back(event);
+    }
+
+
+    void
+    Writer::submit()
+    {
+        if (staged.empty())
+            return;
+
+        {
+            std::lock_guard guard{mutex};
+            if (queue.empty())
+                std::swap(queue, staged);
+            else
+                queue.insert(queue.end(), staged.begin(), staged.end());
+        }
+        staged.clear();
+        cond.notify_one();
+    }
+
+
+    Reader::Reader(const path& filename)
+    {
+        if (!file.open(filename, std::ios::in | std::ios::binary))
+            throw runtime_error{"Could not open " + filename.string()};
+
+        char buf[sizeof magic + 1];
+        if (file.sgetn(buf, sizeof buf) != sizeof buf
+            || string(buf, sizeof magic) != string(magic, sizeof magic))
+            throw runtime_error{filename.string() + " is not a capture file."};
+        const auto version = static_cast<std::uint8_t>(buf[sizeof magic]);
+        if (version != format_version)
+            throw runtime_error{"Unsupported capture format version."};
+
+        header.clock   = get_signed();
+        header.vendor  = get_varint();
+        header.product = get_varint();
+        header.version = get_varint();
+
+        header.name.resize(get_varint());
+        if (file.sgetn(header.name.data(), header.name.size())
+            != static_cast<std::streamsize>(header.name.size()))
+            throw runtime_error{"Truncated capture header."};
+
+        auto num_axes = get_varint();
+        if (num_axes > ABS_CNT)
+            throw runtime_error{"Invalid number of axes in capture header."};
+        for (std::uint64_t i = 0; i < num_axes; ++i) {
+            auto code = get_varint();
+            evdev::AbsInfo info;
+            info.val  = get_signed();
+            info.min  = get_signed();
+            info.max  = get_signed();
+            info.fuzz = get_signed();
+            info.flat = get_signed();
+            info.res  = get_signed();
+            if (code >= ABS_CNT)
+                throw runtime_error{"Invalid axis code in capture header."};
+            last_abs[code] = info.val;
+            header.axes.emplace_back(code, info);
+        }
+    }
+
+
+    bool
+    Reader::get_varint(std::uint64_t& v)
+    {
+        v = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            auto c = file.sbumpc();
+            if (c == std::filebuf::traits_type::eof()) {
+                if (shift == 0)
+                    return false;
+                throw runtime_error{"Truncated capture."};
+            }
+            v |= std::uint64_t(c & 0x7f) << shift;
+            if (!(c & 0x80))
+                return true;
+        }
+        throw runtime_error{"Corrupted capture."};
+    }
+
+
+    std::uint64_t
+    Reader::get_varint()
+    {
+        std::uint64_t v;
+        if (!get_varint(v))
+            throw runtime_error{"Truncated capture."};
+        return v;
+    }
+
+
+    std::int64_t
+    Reader::get_signed()
+    {
+        auto v = get_varint();
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+
+    const Header&
+    Reader::get_header()
+        const noexcept
+    {
+        return header;
+    }
+
+
+    bool
+    Reader::next(input_event& event)
+    {
+        std::uint64_t dt;
+        if (!get_varint(dt))
+            return false;
+        last_time += static_cast<std::int64_t>(dt >> 1) ^ -static_cast<std::int64_t>(dt & 1);
+
+        auto type_code = get_varint();
+        auto value = get_signed();
+
+        event = {};
+        event.input_event_sec  = last_time / 1'000'000;
+        event.input_event_usec = last_time % 1'000'000;
+        event.type = type_code & 0x1f;
+        event.code = type_code >> 5;
+
+        if (event.type == EV_ABS && event.code < ABS_CNT) {
+            last_abs[event.code] += value;
+            event.value = last_abs[event.code];
+        } else
+            event.value = value;
+
+        return true;
+    }
+
+
+    bool
+    Writer::has_failed()
+        const noexcept
+    {
+        return failed;
+    }
+
+} // namespace Capture
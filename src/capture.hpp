@@ -0,0 +1,162 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef CAPTURE_HPP
+#define CAPTURE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <linux/input.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+
+
+/*
+ * Capture files store the identity of a device, followed by every raw event it
+ * produced.
+ *
+ * Format (all integers are LEB128 varints; signed ones are zigzag-encoded first):
+ *
+ *   magic:    "CJCAP" 0x00, then the format version (1 byte).
+ *   clock:    the clockid_t of the event timestamps (signed).
+ *   identity: vendor, product, version, name length, name bytes.
+ *   axes:     count, then for each axis: code, val, min, max, fuzz, flat, res.
+ *   events:   until the end of the file, for each event:
+ *               - time delta from the previous event, in microseconds (signed);
+ *               - (code << 5) | type;
+ *               - value (signed); for EV_ABS, the delta from the previous value of the
+ *                 same axis (starting at the axis' val).
+ */
+namespace Capture {
+
+    // Event timestamp, in microseconds.
+    std::int64_t
+    event_time(const input_event& event)
+        noexcept;
+
+
+    struct Header {
+        // The clock of the event timestamps: CLOCK_MONOTONIC, or CLOCK_REALTIME if the
+        // device couldn't be switched.
+        int clock = CLOCK_REALTIME;
+        std::uint16_t vendor = 0;
+        std::uint16_t product = 0;
+        std::uint16_t version = 0;
+        std::string name;
+        std::vector<std::pair<std::uint16_t, evdev::AbsInfo>> axes;
+    };
+
+
+    /*
+     * Appends events to a capture file.
+     *
+     * Events are staged on the caller's thread, and submitted in batches to a writer
+     * thread, that does the encoding and the file I/O.
+     */
+    class Writer {
+
+        std::ofstream file;
+
+        std::vector<input_event> staged;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<input_event> queue;
+        bool stopping = false;
+
+        std::atomic<bool> failed = false;
+
+        std::thread thread;
+
+        // Encoder state, only used by the writer thread.
+        std::int64_t last_time = 0;
+        int last_abs[ABS_CNT] = {};
+
+
+        void
+        run()
+            noexcept;
+
+        void
+        write_batch(const std::vector<input_event>& batch);
+
+    public:
+
+        Writer(const std::filesystem::path& filename,
+               const Header& header);
+
+        ~Writer()
+            noexcept;
+
+
+        // Stage one event. Must be called always from the same thread.
+        void
+        add(const input_event& event);
+
+        // Hand all staged events to the writer thread.
+        void
+        submit();
+
+
+        bool
+        has_failed()
+            const noexcept;
+
+    }; // class Writer
+
+
+    // Decodes a capture file, one event at a time.
+    class Reader {
+
+        std::filebuf file;
+
+        Header header;
+
+        // Decoder state.
+        std::int64_t last_time = 0;
+        int last_abs[ABS_CNT] = {};
+
+
+        bool
+        get_varint(std::uint64_t& v);
+
+        std::uint64_t
+        get_varint();
+
+        std::int64_t
+        get_signed();
+
+    public:
+
+        explicit
+        Reader(const std::filesystem::path& filename);
+
+
+        const Header&
+        get_header()
+            const noexcept;
+
+
+        // Returns false at the end of the file.
+        bool
+        next(input_event& event);
+
+    }; // class Reader
+
+} // namespace Capture
+
+#endif
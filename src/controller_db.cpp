@@ -8,6 +8,7 @@
 #include <filesystem>
 #include <iostream>
 #include <limits>
+#include <map>
 #include <stdexcept>
 
 #include <wordexp.h>
@@ -79,6 +80,8 @@ namespace ControllerDB {
 
     std::map<Key, DevConf> configs;
 
+    bool initialized = false;
+
 
 #define GLIBMM_FILE_MONITOR_IS_BROKEN
 
@@ -297,10 +300,15 @@ namespace ControllerDB {
 
     void
     initialize()
+        noexcept
     {
-        db_dir = get_user_config_dir() / PACKAGE / "db";
+        if (initialized)
+            return;
+        initialized = true;
 
         try {
+            db_dir = get_user_config_dir() / PACKAGE / "db";
+
             if (!exists(db_dir))
                 create_directories(db_dir);
 
@@ -330,6 +338,11 @@ namespace ControllerDB {
         catch (exception& e) {
             cerr << "Failed to load database: " << e.what() << endl;
         }
+#if !GLIBMM_CHECK_VERSION(2, 68, 0)
+        catch (Glib::Exception& e) {
+            cerr << "Failed to load database: " << e.what() << endl;
+        }
+#endif
     }
 
 
@@ -345,6 +358,8 @@ namespace ControllerDB {
             db_dir_monitor = nullptr;
         }
 #endif
+        configs.clear();
+        initialized = false;
     }
 
 
@@ -396,6 +411,8 @@ namespace ControllerDB {
     {
         using Glib::ustring;
 
+        initialize();
+
         configs.filename = make_filename(vendor, product, version, name);
 
         string vendor_str = ustring::sprintf("%04x", vendor);
@@ -458,6 +475,8 @@ namespace ControllerDB {
          const string& name)
         noexcept
     {
+        initialize();
+
         const Key key{ vendor, product, version, name };
         // Fast path: find an exact match.
         if (auto it = configs.find(key); it != configs.end())
@@ -10,13 +10,15 @@
 
 #include <compare>
 #include <cstdint>
-#include <map>
+#include <filesystem>
 #include <string>
 #include <utility>
 
 #include <libevdevxx/AbsInfo.hpp>
 #include <libevdevxx/Code.hpp>
 
+#include "axis_table.hpp"
+
 
 namespace ControllerDB {
 
@@ -45,13 +47,16 @@ namespace ControllerDB {
 
 
     struct DevConf {
-        std::map<evdev::Code, AxisData> axes;
+        AxisTable<AxisData> axes;
         std::filesystem::path filename;
     };
 
 
+    // Loads the database, and starts monitoring it; find() and save() call this if
+    // needed, so it's only done when a device first shows up.
     void
-    initialize();
+    initialize()
+        noexcept;
 
     void
     finalize()
@@ -0,0 +1,159 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <exception>
+#include <iostream>
+#include <vector>
+
+#include <gudevxx/Enumerator.hpp>
+#include <libevdevxx/Code.hpp>
+#include <libevdevxx/Device.hpp>
+
+#include "daemon.hpp"
+
+#include "axis_table.hpp"
+#include "controller_db.hpp"
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::filesystem::path;
+using std::string;
+
+using evdev::AbsInfo;
+using evdev::Code;
+
+
+Daemon::Daemon(const string& gui_program_) :
+    loop{Glib::MainLoop::create()},
+    gui_program{gui_program_}
+{
+    uclient.create({"input"});
+    uclient.uevent_callback =
+        [this](const string& action,
+               const gudev::Device& device)
+        {
+            on_uevent(action, device);
+        };
+
+    ControllerDB::initialize();
+}
+
+
+Daemon::~Daemon()
+    noexcept
+{
+    ControllerDB::finalize();
+}
+
+
+void
+Daemon::on_uevent(const string& action,
+                  const gudev::Device& device)
+{
+    if (action != "add")
+        return;
+
+    if (auto name = device.name();
+        !name || !name->starts_with("event"))
+        return;
+
+    if (!device.property_as<bool>("ID_INPUT_JOYSTICK"))
+        return;
+
+    auto dev_path = device.device_file();
+    if (!dev_path)
+        return;
+
+    if (!apply(*dev_path) && !gui_program.empty())
+        launch_gui(*dev_path);
+}
+
+
+bool
+Daemon::apply(const path& dev_path)
+try {
+    // Note: the device is closed as soon as this returns.
+    evdev::Device device{dev_path};
+
+    auto [key, conf] = ControllerDB::find(device.get_vendor(),
+                                          device.get_product(),
+                                          device.get_version(),
+                                          device.get_name());
+    if (!key || !conf)
+        return false;
+
+    AxisTable<bool> present;
+    for (auto code : device.get_codes(evdev::Type::abs))
+        if (code < ABS_CNT)
+            present[code] = true;
+
+    for (const auto& [code, axis] : conf->axes) {
+        if (!present.contains(code)) {
+            cerr << "Ignoring axis " << evdev::code_to_string(evdev::Type::abs, code)
+                 << " in config, not present in "
+                 << device.get_name() << endl;
+            continue;
+        }
+        // Note: don't feed a fake zero .val to the kernel.
+        AbsInfo new_info = axis.info;
+        new_info.val = device.get_abs_info(code).val;
+        device.set_kernel_abs_info(code, new_info);
+    }
+
+    cout << "Applied config file for " << device.get_name() << endl;
+    return true;
+}
+catch (std::exception& e) {
+    cerr << "Could not calibrate " << dev_path << ": " << e.what() << endl;
+    // Don't hand a device we can't open to the GUI.
+    return true;
+}
+
+
+void
+Daemon::apply_all()
+{
+    gudev::Enumerator e{uclient};
+
+    e.match_subsystem("input");
+    e.match_property("ID_INPUT_JOYSTICK", "1");
+    e.match_name("event*");
+
+    for (const auto& d : e.execute())
+        if (auto dev_path = d.device_file())
+            apply(*dev_path);
+}
+
+
+void
+Daemon::launch_gui(const path& dev_path)
+{
+    try {
+        // If the GUI is already running, it just opens another page.
+        std::vector<string> argv{gui_program, dev_path.string()};
+        Glib::spawn_async("", argv, Glib::SPAWN_SEARCH_PATH);
+    }
+    catch (Glib::SpawnError& e) {
+        cerr << "Could not launch " << gui_program << ": " << e.what() << endl;
+    }
+}
+
+
+void
+Daemon::run()
+{
+    loop->run();
+}
+
+
+void
+Daemon::quit()
+{
+    loop->quit();
+}
@@ -0,0 +1,68 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef DAEMON_HPP
+#define DAEMON_HPP
+
+#include <filesystem>
+#include <string>
+
+#include <glibmm.h>
+#include <gudevxx/Client.hpp>
+
+
+/*
+ * Applies the saved calibrations to joysticks as they are inserted, without a GUI.
+ *
+ * Each device is only opened long enough to apply its calibration. Devices without a
+ * calibration are handed to the GUI program, if one was given.
+ */
+class Daemon {
+
+    Glib::RefPtr<Glib::MainLoop> loop;
+
+    gudev::Client uclient = nullptr;
+
+    // Launched for devices that have no calibration; empty to disable it.
+    std::string gui_program;
+
+
+    void
+    on_uevent(const std::string& action,
+              const gudev::Device& device);
+
+    void
+    launch_gui(const std::filesystem::path& dev_path);
+
+public:
+
+    explicit
+    Daemon(const std::string& gui_program);
+
+    ~Daemon()
+        noexcept;
+
+
+    // Returns false if there's no calibration for this device.
+    bool
+    apply(const std::filesystem::path& dev_path);
+
+    // Applies the calibrations to the joysticks that are already present.
+    void
+    apply_all();
+
+
+    // Monitors new joysticks, until quit() is called.
+    void
+    run();
+
+    void
+    quit();
+
+}; // class Daemon
+
+#endif
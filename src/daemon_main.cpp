@@ -0,0 +1,100 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <clocale>
+#include <csignal>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include <glib-unix.h>
+#include <giomm.h>
+#include <glibmm.h>
+
+#include "daemon.hpp"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <glibmm/i18n.h>
+
+
+namespace {
+
+    gboolean
+    stop_daemon(Daemon* daemon)
+    {
+        daemon->quit();
+        return G_SOURCE_REMOVE;
+    }
+
+} // namespace
+
+
+int main(int argc, char* argv[])
+{
+    std::setlocale(LC_ALL, "");
+    bindtextdomain(GETTEXT_PACKAGE, LOCALEDIR);
+    bind_textdomain_codeset(PACKAGE, "UTF-8");
+    textdomain(PACKAGE);
+
+    try {
+        Gio::init();
+
+        bool opt_version = false;
+        bool opt_once = false;
+        std::string opt_gui;
+
+        Glib::OptionGroup group{"daemon", ""};
+
+        Glib::OptionEntry version_entry;
+        version_entry.set_long_name("version");
+        version_entry.set_short_name('V');
+        version_entry.set_description(_("Show program version."));
+        group.add_entry(version_entry, opt_version);
+
+        Glib::OptionEntry once_entry;
+        once_entry.set_long_name("once");
+        once_entry.set_description(_("Calibrate the joysticks that are present, and exit."));
+        group.add_entry(once_entry, opt_once);
+
+        Glib::OptionEntry gui_entry;
+        gui_entry.set_long_name("gui");
+        gui_entry.set_short_name('g');
+        gui_entry.set_description(_("Launch PROGRAM for joysticks without a calibration."));
+        gui_entry.set_arg_description(_("PROGRAM"));
+        group.add_entry_filename(gui_entry, opt_gui);
+
+        Glib::OptionContext context;
+        context.set_summary(_("Applies the saved calibrations to joysticks, without a GUI."));
+        context.set_main_group(group);
+        context.parse(argc, argv);
+
+        if (opt_version) {
+            std::cout << PACKAGE_VERSION << std::endl;
+            return 0;
+        }
+
+        Daemon daemon{opt_gui};
+        daemon.apply_all();
+        if (opt_once)
+            return 0;
+
+        g_unix_signal_add(SIGINT, G_SOURCE_FUNC(stop_daemon), &daemon);
+        g_unix_signal_add(SIGTERM, G_SOURCE_FUNC(stop_daemon), &daemon);
+
+        daemon.run();
+    }
+    catch (Glib::Error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+    catch (std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -6,14 +6,21 @@
  */
 
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <exception>
+#include <iomanip>
 #include <iostream>
 #include <utility>
 
 #include "device_page.hpp"
 
 #include "axis_info.hpp"
+#include "capture.hpp"
 #include "controller_db.hpp"
+#include "input_source.hpp"
+#include "overview_canvas.hpp"
+#include "stick_canvas.hpp"
 #include "utils.hpp"
 
 #ifdef HAVE_CONFIG_H
@@ -30,59 +37,94 @@ using std::string;
 
 using namespace std::literals;
 
-using Glib::IOCondition;
 using Glib::ustring;
 using Glib::Variant;
 using Glib::VariantBase;
 
 using evdev::AbsInfo;
 using evdev::Code;
-using evdev::Type;
 
 
 namespace {
 
     const string device_page_glade = RESOURCE_PREFIX "/ui/device-page.glade";
 
+    // How often the timing statistics are refreshed, in milliseconds.
+    constexpr unsigned timing_refresh_ms = 500;
+
+
+    // Devices with this many axes start in the overview mode.
+    constexpr std::size_t overview_min_axes = 16;
+
+
+    // Axis pairs that get a 2D view.
+    const std::pair<std::uint16_t, std::uint16_t> stick_axes[] = {
+        { ABS_X,     ABS_Y     },
+        { ABS_RX,    ABS_RY    },
+        { ABS_HAT0X, ABS_HAT0Y },
+        { ABS_HAT1X, ABS_HAT1Y },
+        { ABS_HAT2X, ABS_HAT2Y },
+        { ABS_HAT3X, ABS_HAT3Y },
+    };
+
+
+    // Formats a time in microseconds, as milliseconds.
+    ustring
+    format_ms(double us)
+    {
+        return ustring::format(std::fixed, std::setprecision(2), us / 1000);
+    }
+
 } // namespace
 
 
-DevicePage::DevicePage(const path& dev_path) :
-    dev_path{dev_path},
-    device{dev_path}
+DevicePage::DevicePage(std::unique_ptr<InputSource> source_) :
+    source{std::move(source_)},
+    created_time{g_get_monotonic_time()}
 {
     load_widgets();
     create_actions();
 
-    name_label->set_label(device.get_name());
-    path_label->set_label(dev_path.string());
+    name_label->set_label(source->get_name());
+    path_label->set_label(source->get_path());
 
-    vendor_label->set_label(ustring::sprintf("%04x", device.get_vendor()));
-    product_label->set_label(ustring::sprintf("%04x", device.get_product()));
-    version_label->set_label(ustring::sprintf("%04x", device.get_version()));
+    vendor_label->set_label(ustring::sprintf("%04x", source->get_vendor()));
+    product_label->set_label(ustring::sprintf("%04x", source->get_product()));
+    version_label->set_label(ustring::sprintf("%04x", source->get_version()));
+    update_drops_label();
+    update_timing_label();
 
-    auto abs_codes = device.get_codes(Type::abs);
+    auto abs_codes = source->get_abs_codes();
     for (auto code : abs_codes) {
-        auto info = device.get_abs_info(code);
-        auto [iter, inserted] = axes.emplace(code, std::make_unique<AxisInfo>(code, info));
-        if (inserted)
-            axes_box->pack_start(iter->second->root(),
-                                 Gtk::PackOptions::PACK_SHRINK);
+        if (code >= ABS_CNT || pending.contains(code))
+            continue;
+        pending[code].value = source->get_abs_info(code).val;
     }
+    frame.reserve(pending.size());
+
+    create_sticks();
+    set_overview(pending.size() >= overview_min_axes);
 
     try_load_config();
 
-    io_conn = Glib::signal_io().connect(sigc::mem_fun(this, &DevicePage::on_io),
-                                        device.get_fd(),
-                                        IOCondition::IO_IN |
-                                        IOCondition::IO_ERR |
-                                        IOCondition::IO_HUP);
+    update_event_mask();
+    source->start([this](std::span<const input_event> events) { on_events(events); },
+                  [this](const string& reason) { on_source_stop(reason); });
+
+    timing_conn = Glib::signal_timeout()
+        .connect(sigc::mem_fun(this, &DevicePage::update_timing_label),
+                 timing_refresh_ms);
+
+    device_box->signal_map().connect(sigc::mem_fun(this, &DevicePage::on_map));
 }
 
 
 DevicePage::~DevicePage()
 {
-    io_conn.disconnect();
+    timing_conn.disconnect();
+    idle_conn.disconnect();
+    source->stop();
+    stop_recording();
 }
 
 
@@ -120,6 +162,14 @@ DevicePage::create_actions()
                                            Glib::VARIANT_TYPE_UINT16,
                                            sigc::mem_fun(this,
                                                          &DevicePage::on_action_revert_axis));
+
+    record_action =
+        actions->add_action_bool("record",
+                                 sigc::mem_fun(this, &DevicePage::on_action_record));
+
+    overview_action =
+        actions->add_action_bool("overview",
+                                 sigc::mem_fun(this, &DevicePage::on_action_overview));
 }
 
 
@@ -135,6 +185,8 @@ DevicePage::load_widgets()
     builder->get_widget("vendor_label", vendor_label);
     builder->get_widget("product_label", product_label);
     builder->get_widget("version_label", version_label);
+    builder->get_widget("drops_label", drops_label);
+    builder->get_widget("timing_label", timing_label);
 
     builder->get_widget("name_check", name_check);
     builder->get_widget("vendor_check", vendor_check);
@@ -142,11 +194,29 @@ DevicePage::load_widgets()
     builder->get_widget("version_check", version_check);
 
     builder->get_widget("axes_box", axes_box);
+    builder->get_widget("sticks_box", sticks_box);
     builder->get_widget("info_bar", info_bar);
     builder->get_widget("error_label", error_label);
 }
 
 
+void
+DevicePage::create_sticks()
+{
+    for (auto [x, y] : stick_axes) {
+        if (!pending.contains(x) || !pending.contains(y))
+            continue;
+        auto& stick = sticks.emplace_back(std::make_unique<StickCanvas>(x,
+                                                                        source->get_abs_info(x),
+                                                                        y,
+                                                                        source->get_abs_info(y)));
+        sticks_box->add(*stick);
+        stick->show();
+    }
+    sticks_box->set_visible(!sticks.empty());
+}
+
+
 Gtk::Widget&
 DevicePage::root()
 {
@@ -160,46 +230,219 @@ string
 DevicePage::get_name()
     const
 {
-    return device.get_name();
+    return source->get_name();
 }
 
 
-bool
-DevicePage::on_io(IOCondition cond)
+void
+DevicePage::on_events(std::span<const input_event> events)
+{
+    for (const auto& event : events)
+        process_event(event);
+
+    // The source might have seen events that it couldn't deliver; use its extremes to
+    // keep the min/max exact.
+    for (auto& [code, p] : pending) {
+        int low, high, last;
+        if (!source->take_extremes(code, low, high, last))
+            continue;
+        if (!p.dirty) {
+            p.value = p.low = p.high = last;
+            p.dirty = true;
+        }
+        p.active = true;
+        if (low != INT_MAX)
+            p.low = std::min(p.low, low);
+        if (high != INT_MIN)
+            p.high = std::max(p.high, high);
+    }
+
+    // Only touch the widgets once, no matter how many frames were received.
+    flush_pending();
+}
+
+
+void
+DevicePage::on_source_stop(const string& reason)
 {
-    if (cond & (IOCondition::IO_HUP | IOCondition::IO_ERR)) {
-        disable();
+    report_error(reason);
+}
 
-        if (cond & IOCondition::IO_HUP)
-            error_label->set_text(_("Device disconnected."));
-        else
-            error_label->set_text(_("Input/output error."));
-        info_bar->show();
-        info_bar->set_property("revealed", true);
 
-        return false;
+void
+DevicePage::process_event(const input_event& event)
+{
+    if (recorder)
+        recorder->add(event);
+
+    if (event.type == EV_ABS) {
+        // Codes the device didn't advertise are ignored.
+        if (!dropping && pending.contains(event.code))
+            frame.emplace_back(Code{event.code}, event.value);
+        return;
     }
 
-    if (cond & IOCondition::IO_IN)
-        handle_read();
+    if (event.type != EV_SYN)
+        return;
 
-    return true;
+    switch (event.code) {
+
+        case SYN_REPORT:
+            last_report_time = Capture::event_time(event);
+            timing.add(last_report_time);
+            if (dropping) {
+                dropping = false;
+                resync();
+            } else
+                commit_frame();
+            break;
+
+        case SYN_DROPPED:
+            // The current frame is incomplete, and the next one may be too.
+            frame.clear();
+            dropping = true;
+            ++drops;
+            break;
+
+    }
 }
 
 
 void
-DevicePage::handle_read()
+DevicePage::commit_frame()
 {
-    while (device.has_pending()) {
-        auto event = device.read();
-        if (event.type != Type::abs)
+    std::uint64_t changed = 0;
+    for (auto [code, value] : frame) {
+        changed |= std::uint64_t{1} << code;
+        auto* pa = pending.find(code);
+        if (!pa)
             continue;
+        auto& p = *pa;
+        if (!p.dirty) {
+            p.low = p.high = value;
+            p.dirty = true;
+        } else {
+            p.low = std::min(p.low, value);
+            p.high = std::max(p.high, value);
+        }
+        p.value = value;
+        p.active = true;
+        if (auto axis = find_axis(code))
+            axis->add_sample(last_report_time, value);
+    }
+    frame.clear();
 
-        axes.at(event.code)->set_calc_value(event.value);
+    for (auto& stick : sticks) {
+        auto x = stick->get_x_code();
+        auto y = stick->get_y_code();
+        if (changed & ((std::uint64_t{1} << x) | (std::uint64_t{1} << y)))
+            stick->add_point(pending[x].value, pending[y].value);
     }
 }
 
 
+void
+DevicePage::flush_pending()
+{
+    if (recorder)
+        recorder->submit();
+
+    for (auto& stick : sticks)
+        stick->flush();
+
+    // Pages that are not shown only keep the model (pending) up to date; the widgets
+    // catch up in one step when the page is mapped again.
+    if (!device_box->get_mapped())
+        return;
+
+    bool overview_changed = false;
+    for (auto& [code, p] : pending) {
+        if (!p.dirty)
+            continue;
+        if (p.hidden)
+            set_axis_hidden(code, false);
+        if (auto axis = find_axis(code))
+            axis->set_calc_value(p.value, p.low, p.high);
+        if (auto row = find_row(code)) {
+            row->calc.val = p.value;
+            row->calc.min = std::min(row->calc.min, p.low);
+            row->calc.max = std::max(row->calc.max, p.high);
+            overview_changed = true;
+        }
+        p.dirty = false;
+    }
+    if (overview_changed)
+        overview->schedule_draw();
+
+    // Idle axes' trails scroll too.
+    for (auto& [code, axis] : axes)
+        axis->set_trail_time(last_report_time);
+}
+
+
+void
+DevicePage::resync()
+{
+    // Query the current state of all axes, and commit it as a frame.
+    for (auto& [code, p] : pending)
+        if (auto value = source->query_abs_value(code))
+            frame.emplace_back(code, *value);
+    commit_frame();
+
+    ++resyncs;
+    update_drops_label();
+
+    cerr << "Events dropped for " << source->get_name()
+         << ", resynced axes (" << drops << " drops, "
+         << resyncs << " resyncs)" << endl;
+}
+
+
+void
+DevicePage::update_drops_label()
+{
+    drops_label->set_label(ustring::compose(_("%1 drops, %2 resyncs"),
+                                            drops,
+                                            resyncs));
+}
+
+
+void
+DevicePage::on_map()
+{
+    flush_pending();
+    update_timing_label();
+}
+
+
+bool
+DevicePage::update_timing_label()
+{
+    // Refreshed when the page is mapped again.
+    if (!device_box->get_mapped())
+        return true;
+
+    auto summary = timing.summarize();
+    if (!summary) {
+        timing_label->set_label(_("waiting for reports"));
+        return true;
+    }
+
+    timing_label->set_label(ustring::compose(_("%1 Hz, interval: mean %2 ms, "
+                                               "p50 %3 ms, p99 %4 ms, max %5 ms, "
+                                               "jitter %6 ms"),
+                                             ustring::format(std::fixed,
+                                                             std::setprecision(0),
+                                                             summary->rate),
+                                             format_ms(summary->mean),
+                                             format_ms(summary->p50),
+                                             format_ms(summary->p99),
+                                             format_ms(summary->max),
+                                             format_ms(summary->stddev)));
+    return true;
+}
+
+
 void
 DevicePage::on_action_save()
 {
@@ -207,15 +450,15 @@ DevicePage::on_action_save()
         filename.clear();
         delete_action->set_enabled(false);
 
-        auto vendor = vendor_check->get_active() ? device.get_vendor() : 0;
-        auto product = product_check->get_active() ? device.get_product() : 0;
-        auto version = version_check->get_active() ? device.get_version() : 0;
-        auto name = name_check->get_active() ? device.get_name() : ""s;
+        auto vendor = vendor_check->get_active() ? source->get_vendor() : 0;
+        auto product = product_check->get_active() ? source->get_product() : 0;
+        auto version = version_check->get_active() ? source->get_version() : 0;
+        auto name = name_check->get_active() ? source->get_name() : ""s;
         ControllerDB::DevConf conf;
-        for  (const auto& [axis, ainfo] : axes) {
+        for (const auto& [axis, _] : pending) {
             auto& data = conf.axes[axis];
-            data.info = device.get_abs_info(axis);
-            data.flat_centered = ainfo->is_flat_centered();
+            data.info = source->get_abs_info(axis);
+            data.flat_centered = is_flat_centered(axis);
         }
         ControllerDB::save(vendor, product, version, name, conf);
 
@@ -245,7 +488,7 @@ DevicePage::on_action_delete()
 void
 DevicePage::on_action_apply_all()
 {
-    for (auto& [code, _] : axes)
+    for (auto& [code, _] : pending)
         apply_axis(code);
 }
 
@@ -253,7 +496,7 @@ DevicePage::on_action_apply_all()
 void
 DevicePage::on_action_revert_all()
 {
-    for (auto& [code, _] : axes)
+    for (auto& [code, _] : pending)
         revert_axis(code);
 }
 
@@ -274,14 +517,296 @@ DevicePage::on_action_revert_axis(const VariantBase& arg)
 }
 
 
+void
+DevicePage::on_action_record()
+{
+    bool recording = false;
+    record_action->get_state(recording);
+    if (recording)
+        stop_recording();
+    else
+        start_recording();
+}
+
+
+void
+DevicePage::start_recording()
+{
+    auto window = dynamic_cast<Gtk::Window*>(root().get_toplevel());
+
+    Gtk::FileChooserDialog diag{_("Record events to..."),
+                                Gtk::FileChooserAction::FILE_CHOOSER_ACTION_SAVE};
+    if (window)
+        diag.set_transient_for(*window);
+    diag.set_do_overwrite_confirmation();
+    diag.set_current_name(source->get_name() + ".cap");
+
+    diag.add_button(_("_Cancel"), Gtk::ResponseType::RESPONSE_CANCEL);
+    diag.add_button(_("_Record"), Gtk::ResponseType::RESPONSE_ACCEPT);
+
+    auto cap_filter = Gtk::FileFilter::create();
+    cap_filter->set_name(_("capture files"));
+    cap_filter->add_pattern("*.cap");
+    diag.add_filter(cap_filter);
+
+    if (diag.run() != Gtk::ResponseType::RESPONSE_ACCEPT)
+        return;
+
+    try {
+        Capture::Header header;
+        header.clock   = source->get_clock();
+        header.vendor  = source->get_vendor();
+        header.product = source->get_product();
+        header.version = source->get_version();
+        header.name    = source->get_name();
+        for (auto& [code, _] : pending)
+            header.axes.emplace_back(code, source->get_abs_info(code));
+
+        path cap_path = diag.get_filename();
+        recorder = std::make_unique<Capture::Writer>(cap_path, header);
+        update_event_mask();
+        record_action->change_state(true);
+        cout << "Recording " << source->get_name() << " to " << cap_path << endl;
+    }
+    catch (std::exception& e) {
+        cerr << "Failed to start recording: " << e.what() << endl;
+    }
+}
+
+
+void
+DevicePage::stop_recording()
+{
+    if (!recorder)
+        return;
+
+    // Note: the destructor submits the remaining events and waits for the writer.
+    bool failed = recorder->has_failed();
+    recorder.reset();
+    update_event_mask();
+    if (failed)
+        cerr << "Recording of " << source->get_name() << " failed." << endl;
+    if (record_action)
+        record_action->change_state(false);
+}
+
+
+void
+DevicePage::update_event_mask()
+{
+    InputSource::TypeMask types;
+    if (recorder) {
+        // Captures keep every event.
+        types.set();
+    } else {
+        types.set(EV_SYN);
+        types.set(EV_ABS);
+    }
+    source->set_event_mask(types);
+}
+
+
+void
+DevicePage::on_action_overview()
+{
+    bool enabled = false;
+    overview_action->get_state(enabled);
+    set_overview(!enabled);
+}
+
+
+void
+DevicePage::set_overview(bool enable)
+{
+    if (enable) {
+        overview = std::make_unique<OverviewCanvas>([this](Code code)
+        {
+            on_overview_activate(code);
+        });
+        for (auto& [code, p] : pending) {
+            auto& row = overview->add_row(code, source->get_abs_info(code));
+            if (auto axis = find_axis(code)) {
+                row.calc = axis->get_calc();
+                row.flat_centered = axis->is_flat_centered();
+            }
+            if (p.hidden)
+                overview->set_row_hidden(code, true);
+        }
+        axes.clear();
+        overview->set_colors(colors);
+        axes_box->pack_start(*overview, Gtk::PackOptions::PACK_SHRINK);
+        overview->show();
+    } else {
+        close_editor();
+        for (auto& [code, _] : pending)
+            create_axis(code);
+        overview.reset();
+    }
+    overview_action->change_state(enable);
+}
+
+
+void
+DevicePage::on_overview_activate(Code code)
+{
+    // Clicking the axis being edited just closes the editor.
+    const bool was_editing = axes.contains(code);
+    close_editor();
+    if (was_editing)
+        return;
+    create_axis(code);
+    overview->set_selected(code);
+}
+
+
+void
+DevicePage::close_editor()
+{
+    if (!overview)
+        return;
+    for (auto& [code, axis] : axes)
+        if (auto row = overview->find_row(code)) {
+            row->calc = axis->get_calc();
+            row->flat_centered = axis->is_flat_centered();
+        }
+    axes.clear();
+    overview->set_selected({});
+}
+
+
+AxisInfo&
+DevicePage::create_axis(Code code)
+{
+    auto& axis = axes[code];
+    axis = std::make_unique<AxisInfo>(code, source->get_abs_info(code));
+    axis->begin_update();
+    if (auto row = find_row(code)) {
+        axis->set_calc(row->calc);
+        axis->set_flat_centered(row->flat_centered);
+    }
+    axis->set_colors(colors);
+    axis->commit_update();
+    // Edits made in the editor show up in the overview right away.
+    axis->signal_changed().connect([this, code] { on_axis_changed(code); });
+    if (disabled)
+        axis->disable();
+    axes_box->pack_start(axis->root(),
+                         Gtk::PackOptions::PACK_SHRINK);
+    if (pending[code].hidden)
+        axis->root().hide();
+    return *axis;
+}
+
+
+void
+DevicePage::hide_idle_axes()
+{
+    for (auto& [code, p] : pending) {
+        // Don't pull the editor away from the user.
+        if (p.active || (overview && axes.contains(code)))
+            continue;
+        set_axis_hidden(code, true);
+    }
+}
+
+
+void
+DevicePage::set_axis_hidden(Code code,
+                            bool hidden)
+{
+    pending[code].hidden = hidden;
+    if (auto axis = find_axis(code))
+        axis->root().set_visible(!hidden);
+    if (find_row(code))
+        overview->set_row_hidden(code, hidden);
+}
+
+
+void
+DevicePage::on_axis_changed(Code code)
+{
+    auto axis = find_axis(code);
+    auto row = find_row(code);
+    if (!axis || !row)
+        return;
+    row->calc = axis->get_calc();
+    overview->schedule_draw();
+}
+
+
+AxisInfo*
+DevicePage::find_axis(Code code)
+    noexcept
+{
+    auto axis = axes.find(code);
+    return axis ? axis->get() : nullptr;
+}
+
+
+OverviewCanvas::Row*
+DevicePage::find_row(Code code)
+    noexcept
+{
+    return overview ? overview->find_row(code) : nullptr;
+}
+
+
+AbsInfo
+DevicePage::get_calc(Code code)
+{
+    if (auto axis = find_axis(code))
+        return axis->get_calc();
+    if (auto row = find_row(code))
+        return row->calc;
+    return source->get_abs_info(code);
+}
+
+
+bool
+DevicePage::is_flat_centered(Code code)
+{
+    if (auto axis = find_axis(code))
+        return axis->is_flat_centered();
+    if (auto row = find_row(code))
+        return row->flat_centered;
+    return false;
+}
+
+
+void
+DevicePage::set_flat_centered(Code code,
+                              bool centered)
+{
+    if (auto axis = find_axis(code))
+        axis->set_flat_centered(centered);
+    if (auto row = find_row(code)) {
+        row->flat_centered = centered;
+        overview->schedule_draw();
+    }
+}
+
+
+void
+DevicePage::reset_axis(Code code,
+                       const AbsInfo& new_orig)
+{
+    if (auto axis = find_axis(code))
+        axis->reset(new_orig);
+    if (auto row = find_row(code)) {
+        row->orig = row->calc = new_orig;
+        row->calc.min = row->calc.max = new_orig.val;
+        overview->schedule_draw();
+    }
+}
+
+
 void
 DevicePage::apply_axis(Code code)
 {
-    if (!device.is_open())
+    if (!source->is_open() || !pending.contains(code))
         return;
 
-    device.set_kernel_abs_info(code,
-                               axes.at(code)->get_calc());
+    source->set_abs_info(code, get_calc(code));
     revert_axis(code);
 }
 
@@ -289,11 +814,15 @@ DevicePage::apply_axis(Code code)
 void
 DevicePage::revert_axis(Code code)
 {
-    if (!device.is_open())
+    if (!source->is_open() || !pending.contains(code))
         return;
 
-    auto new_abs = device.get_abs_info(code);
-    axes.at(code)->reset(new_abs);
+    reset_axis(code, source->get_abs_info(code));
+
+    // The coverage restarts along with the min/max.
+    for (auto& stick : sticks)
+        if (stick->get_x_code() == code || stick->get_y_code() == code)
+            stick->clear();
 }
 
 
@@ -307,32 +836,57 @@ DevicePage::disable()
     apply_axis_action->set_enabled(false);
     revert_axis_action->set_enabled(false);
 
+    stop_recording();
+    record_action->set_enabled(false);
+
+    // Keep the last timing statistics visible.
+    update_timing_label();
+    timing_conn.disconnect();
+
+    disabled = true;
     for (auto& [_, axis] : axes)
         axis->disable();
 }
 
 
+void
+DevicePage::report_error(const ustring& msg)
+{
+    disable();
+
+    error_label->set_text(msg);
+    info_bar->show();
+    info_bar->set_property("revealed", true);
+}
+
+
 void
 DevicePage::try_load_config()
 {
     filename.clear();
     delete_action->set_enabled(false);
 
-    auto [key, conf] = ControllerDB::find(device.get_vendor(),
-                                          device.get_product(),
-                                          device.get_version(),
-                                          device.get_name());
+    auto [key, conf] = ControllerDB::find(source->get_vendor(),
+                                          source->get_product(),
+                                          source->get_version(),
+                                          source->get_name());
     if (!key || !conf)
         return;
 
     for (const auto& [code, axis] : conf->axes) {
-        axes.at(code)->set_flat_centered(axis.flat_centered);
+        if (!pending.contains(code)) {
+            cerr << "Ignoring axis " << evdev::code_to_string(evdev::Type::abs, code)
+                 << " in config, not present in "
+                 << source->get_name() << endl;
+            continue;
+        }
+        set_flat_centered(code, axis.flat_centered);
         // Note: don't feed a fake zero .val to the kernel nor to the axis_info children.
         AbsInfo new_info = axis.info;
-        new_info.val = device.get_abs_info(code).val;
-        device.set_kernel_abs_info(code, new_info);
+        new_info.val = source->get_abs_info(code).val;
+        source->set_abs_info(code, new_info);
         // cout << "Resetting axis " << code_to_string(type, code) << " to " << new_info << endl;
-        axes.at(code)->reset(new_info);
+        reset_axis(code, new_info);
     }
 
     // Activate checkbuttons based on what the matching key has.
@@ -344,15 +898,48 @@ DevicePage::try_load_config()
     filename = conf->filename;
     delete_action->set_enabled(true);
 
-    cout << "Applied config file for " << device.get_name() << endl;
+    cout << "Applied config file for " << source->get_name() << endl;
 }
 
 
 void
 DevicePage::set_colors(const Colors& c)
 {
+    colors = c;
+    if (overview)
+        overview->set_colors(c);
     for (auto& [key, val] : axes)
         val->set_colors(c);
+    for (auto& stick : sticks)
+        stick->set_colors(c);
+}
+
+
+void
+DevicePage::set_idle_timeout(unsigned seconds)
+{
+    idle_timeout = seconds;
+    idle_conn.disconnect();
+
+    if (!idle_timeout) {
+        for (auto& [code, p] : pending)
+            if (p.hidden)
+                set_axis_hidden(code, false);
+        return;
+    }
+
+    const auto deadline = created_time + std::int64_t{idle_timeout} * 1'000'000;
+    const auto wait = deadline - g_get_monotonic_time();
+    if (wait <= 0) {
+        hide_idle_axes();
+        return;
+    }
+    idle_conn = Glib::signal_timeout().connect([this]
+    {
+        hide_idle_axes();
+        return false;
+    },
+    wait / 1000 + 1);
 }
 
 
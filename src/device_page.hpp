@@ -8,27 +8,37 @@
 #ifndef DEVICE_PAGE_HPP
 #define DEVICE_PAGE_HPP
 
+#include <cstdint>
 #include <filesystem>
-#include <map>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gtkmm.h>
-#include <libevdevxx/Device.hpp>
-#include <libevdevxx/Event.hpp>
 #include <libevdevxx/Code.hpp>
 
+#include <linux/input.h>
+
+#include "axis_table.hpp"
 #include "colors.hpp"
+#include "overview_canvas.hpp"
+#include "report_timing.hpp"
 
 
 class AxisInfo;
+class InputSource;
+class StickCanvas;
 
+namespace Capture {
+    class Writer;
+}
 
-class DevicePage {
 
-    std::filesystem::path dev_path;
+class DevicePage {
 
-    evdev::Device device;
+    std::unique_ptr<InputSource> source;
 
     Glib::RefPtr<Gio::SimpleActionGroup> actions;
     Glib::RefPtr<Gio::SimpleAction> save_action;
@@ -37,6 +47,8 @@ class DevicePage {
     Glib::RefPtr<Gio::SimpleAction> revert_all_action;
     Glib::RefPtr<Gio::SimpleAction> apply_axis_action;
     Glib::RefPtr<Gio::SimpleAction> revert_axis_action;
+    Glib::RefPtr<Gio::SimpleAction> record_action;
+    Glib::RefPtr<Gio::SimpleAction> overview_action;
 
     std::unique_ptr<Gtk::Box> device_box;
 
@@ -45,6 +57,8 @@ class DevicePage {
     Gtk::Label* vendor_label  = nullptr;
     Gtk::Label* product_label = nullptr;
     Gtk::Label* version_label = nullptr;
+    Gtk::Label* drops_label   = nullptr;
+    Gtk::Label* timing_label  = nullptr;
 
     Gtk::CheckButton* name_check    = nullptr;
     Gtk::CheckButton* vendor_check  = nullptr;
@@ -52,16 +66,60 @@ class DevicePage {
     Gtk::CheckButton* version_check = nullptr;
 
     Gtk::Box* axes_box = nullptr;
+    Gtk::FlowBox* sticks_box = nullptr;
 
     Gtk::InfoBar* info_bar    = nullptr;
     Gtk::Label*   error_label = nullptr;
 
-    std::map<evdev::Code, std::unique_ptr<AxisInfo>> axes;
+    // All axes, or in overview mode only the one being edited.
+    AxisTable<std::unique_ptr<AxisInfo>> axes;
+
+    // In overview mode, holds the state of the axes that don't have an AxisInfo.
+    std::unique_ptr<OverviewCanvas> overview;
+
+    Colors colors;
+    bool disabled = false;
+
+    // 2D views of the axis pairs (X/Y, RX/RY, hats).
+    std::vector<std::unique_ptr<StickCanvas>> sticks;
+
+    // Axis values received since the last SYN_REPORT.
+    std::vector<std::pair<evdev::Code, int>> frame;
+
+    // Committed frames, accumulated until they're flushed into the widgets.
+    struct PendingAxis {
+        int value = 0;
+        int low = 0;
+        int high = 0;
+        bool dirty = false;
+        // Set once the axis produced an event.
+        bool active = false;
+        bool hidden = false;
+    };
+    AxisTable<PendingAxis> pending;
+
+    // Set by SYN_DROPPED; events are discarded until the next SYN_REPORT.
+    bool dropping = false;
+    // SYN_DROPPED markers seen; each one may stand for any number of lost events.
+    std::uint64_t drops = 0;
+    std::uint64_t resyncs = 0;
 
-    sigc::connection io_conn;
+    // Timestamp of the latest SYN_REPORT, in microseconds.
+    std::int64_t last_report_time = 0;
+
+    // Intervals between SYN_REPORT timestamps.
+    ReportTiming timing;
+    sigc::connection timing_conn;
+
+    // Axes that stay inactive for this long after the page is created get hidden.
+    unsigned idle_timeout = 0; // seconds; 0 disables it
+    std::int64_t created_time = 0;
+    sigc::connection idle_conn;
 
     std::filesystem::path filename;
 
+    std::unique_ptr<Capture::Writer> recorder;
+
 
     void
     create_actions();
@@ -69,11 +127,36 @@ class DevicePage {
     void
     load_widgets();
 
+    void
+    create_sticks();
+
+    void
+    on_events(std::span<const input_event> events);
+
+    void
+    on_source_stop(const std::string& reason);
+
+    void
+    process_event(const input_event& event);
+
+    void
+    commit_frame();
+
+    void
+    flush_pending();
+
+    void
+    resync();
+
+    void
+    update_drops_label();
+
     bool
-    on_io(Glib::IOCondition cond);
+    update_timing_label();
 
+    // Brings the widgets up to date, after the page was hidden.
     void
-    handle_read();
+    on_map();
 
 
     void
@@ -94,6 +177,75 @@ class DevicePage {
     void
     on_action_revert_axis(const Glib::VariantBase& arg);
 
+    void
+    on_action_record();
+
+    void
+    on_action_overview();
+
+
+    void
+    set_overview(bool enable);
+
+    void
+    on_overview_activate(evdev::Code code);
+
+    // Saves the editor's state into the overview, and destroys it.
+    void
+    close_editor();
+
+    AxisInfo&
+    create_axis(evdev::Code code);
+
+    // Copies the editor's calc into its overview row.
+    void
+    on_axis_changed(evdev::Code code);
+
+
+    void
+    hide_idle_axes();
+
+    void
+    set_axis_hidden(evdev::Code code,
+                    bool hidden);
+
+
+    void
+    start_recording();
+
+    void
+    stop_recording();
+
+    void
+    update_event_mask();
+
+
+    // Returns nullptr if the device doesn't have this axis.
+    AxisInfo*
+    find_axis(evdev::Code code)
+        noexcept;
+
+    // Returns nullptr if not in overview mode.
+    OverviewCanvas::Row*
+    find_row(evdev::Code code)
+        noexcept;
+
+
+    // These work on the AxisInfo and on the overview row, whichever exist.
+
+    evdev::AbsInfo
+    get_calc(evdev::Code code);
+
+    bool
+    is_flat_centered(evdev::Code code);
+
+    void
+    set_flat_centered(evdev::Code code,
+                      bool centered);
+
+    void
+    reset_axis(evdev::Code code,
+               const evdev::AbsInfo& new_orig);
 
     void
     apply_axis(evdev::Code code);
@@ -104,6 +256,9 @@ class DevicePage {
     void
     disable();
 
+    void
+    report_error(const Glib::ustring& msg);
+
     void
     try_load_config();
 
@@ -112,7 +267,8 @@ class DevicePage {
 
 public:
 
-    DevicePage(const std::filesystem::path& dev_path);
+    explicit
+    DevicePage(std::unique_ptr<InputSource> source);
 
     ~DevicePage();
 
@@ -129,6 +285,10 @@ public:
     void
     set_colors(const Colors& c);
 
+    // Hide the axes that produced no events in the first seconds; 0 shows all axes.
+    void
+    set_idle_timeout(unsigned seconds);
+
 
     bool
     has_loaded_config()
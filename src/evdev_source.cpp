@@ -0,0 +1,351 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+
+#include <libevdev/libevdev.h>
+
+#include "evdev_source.hpp"
+
+#include "raw_reader.hpp"
+#include "reader_thread.hpp"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <glibmm/i18n.h>
+
+
+using std::cerr;
+using std::endl;
+using std::filesystem::path;
+using std::string;
+
+using evdev::AbsInfo;
+using evdev::Code;
+using evdev::Type;
+
+
+EvdevSource::EvdevSource(DeviceProbe&& probe,
+                         ReadMode read_mode,
+                         Reactor& reactor) :
+    dev_path{std::move(probe.dev_path)},
+    device{std::move(probe.device)},
+    read_mode{read_mode},
+    reactor(reactor)
+{
+    if (!device)
+        throw std::runtime_error{probe.error};
+
+    // Timestamp events with a clock that doesn't jump, so intervals are meaningful.
+    int clock_id = CLOCK_MONOTONIC;
+    if (ioctl(device->get_fd(), EVIOCSCLOCKID, &clock_id) < 0)
+        cerr << "Could not set the event clock of " << dev_path << endl;
+    else
+        clock = CLOCK_MONOTONIC;
+}
+
+
+EvdevSource::~EvdevSource()
+    noexcept
+{
+    stop();
+}
+
+
+string
+EvdevSource::get_path()
+    const
+{
+    return dev_path.string();
+}
+
+
+string
+EvdevSource::get_name()
+    const
+{
+    return device->get_name();
+}
+
+
+std::uint16_t
+EvdevSource::get_vendor()
+    const
+{
+    return device->get_vendor();
+}
+
+
+std::uint16_t
+EvdevSource::get_product()
+    const
+{
+    return device->get_product();
+}
+
+
+std::uint16_t
+EvdevSource::get_version()
+    const
+{
+    return device->get_version();
+}
+
+
+clockid_t
+EvdevSource::get_clock()
+    const noexcept
+{
+    return clock;
+}
+
+
+std::vector<Code>
+EvdevSource::get_abs_codes()
+    const
+{
+    auto codes = device->get_codes(Type::abs);
+    return {codes.begin(), codes.end()};
+}
+
+
+AbsInfo
+EvdevSource::get_abs_info(Code code)
+    const
+{
+    // When libevdev isn't reading the events, its cached state is outdated.
+    if (read_mode != ReadMode::libevdev) {
+        input_absinfo abs;
+        if (ioctl(device->get_fd(), EVIOCGABS(code), &abs) == 0) {
+            AbsInfo info;
+            info.val  = abs.value;
+            info.min  = abs.minimum;
+            info.max  = abs.maximum;
+            info.fuzz = abs.fuzz;
+            info.flat = abs.flat;
+            info.res  = abs.resolution;
+            return info;
+        }
+    }
+    return device->get_abs_info(code);
+}
+
+
+void
+EvdevSource::set_abs_info(Code code,
+                          const AbsInfo& info)
+{
+    device->set_kernel_abs_info(code, info);
+}
+
+
+std::optional<int>
+EvdevSource::query_abs_value(Code code)
+{
+    // Note: libevdev already resynced its state, don't query the device again.
+    if (read_mode == ReadMode::libevdev) {
+        int value;
+        if (!libevdev_fetch_event_value(device->data(), EV_ABS, code, &value))
+            return {};
+        return value;
+    }
+
+    input_absinfo abs;
+    if (ioctl(device->get_fd(), EVIOCGABS(code), &abs) < 0)
+        return {};
+    return abs.value;
+}
+
+
+bool
+EvdevSource::is_open()
+    const noexcept
+{
+    return device->is_open();
+}
+
+
+void
+EvdevSource::start(EventsSlot on_events_,
+                   StopSlot on_stop_)
+{
+    on_events = std::move(on_events_);
+    on_stop = std::move(on_stop_);
+
+    switch (read_mode) {
+        case ReadMode::raw:
+            raw_reader = std::make_unique<RawReader>(device->get_fd());
+            [[fallthrough]];
+
+        case ReadMode::libevdev:
+            watch_id = reactor.add(device->get_fd(),
+                                   [this](std::uint32_t events) { on_io(events); });
+            break;
+
+        case ReadMode::thread:
+            reader_dispatcher.connect(sigc::mem_fun(this, &EvdevSource::on_reader_ready));
+            reader = std::make_unique<ReaderThread>(device->get_fd(),
+                                                    [this] { reader_dispatcher.emit(); });
+            break;
+    }
+}
+
+
+void
+EvdevSource::stop()
+    noexcept
+{
+    if (watch_id) {
+        reactor.remove(watch_id);
+        watch_id = 0;
+    }
+    raw_reader.reset();
+    reader.reset();
+}
+
+
+bool
+EvdevSource::take_extremes(Code code,
+                           int& low,
+                           int& high,
+                           int& last)
+    noexcept
+{
+    if (!reader)
+        return false;
+    return reader->take_extremes(code, low, high, last);
+}
+
+
+void
+EvdevSource::set_event_mask(const TypeMask& types)
+{
+    // Note: the kernel reads the mask as an array of unsigned long.
+    unsigned long bits[(EV_CNT + LONG_BIT - 1) / LONG_BIT] = {};
+    for (unsigned type = 0; type < EV_CNT; ++type)
+        if (type == EV_SYN || types[type])
+            bits[type / LONG_BIT] |= 1ul << (type % LONG_BIT);
+
+    input_mask mask{};
+    mask.type = 0; // event types, not codes
+    mask.codes_size = sizeof bits;
+    mask.codes_ptr = reinterpret_cast<std::uintptr_t>(bits);
+
+    // Older kernels don't support it; then we just get more events.
+    if (ioctl(device->get_fd(), EVIOCSMASK, &mask) < 0 && errno != ENODEV)
+        cerr << "Could not set the event mask of " << dev_path << endl;
+}
+
+
+void
+EvdevSource::on_io(std::uint32_t events)
+{
+    if (events & EPOLLHUP)
+        return fail(_("Device disconnected."));
+    if (events & EPOLLERR)
+        return fail(_("Input/output error."));
+
+    if (events & EPOLLIN) {
+        if (raw_reader)
+            handle_raw_read();
+        else
+            handle_read();
+    }
+}
+
+
+void
+EvdevSource::handle_read()
+{
+    // Note: use libevdev directly, to get the events with their kernel timestamps.
+    auto dev = device->data();
+
+    batch.clear();
+    while (libevdev_has_event_pending(dev) > 0) {
+        input_event event;
+        int status = libevdev_next_event(dev, LIBEVDEV_READ_FLAG_NORMAL, &event);
+        if (status == -EAGAIN)
+            break;
+        if (status < 0) {
+            on_events(batch);
+            return fail(status == -ENODEV
+                        ? _("Device disconnected.")
+                        : _("Input/output error."));
+        }
+        batch.push_back(event);
+
+        // After a SYN_DROPPED, libevdev queries the device, and reports what changed as
+        // sync events; the page resyncs from libevdev's state once they end.
+        if (status == LIBEVDEV_READ_STATUS_SYNC)
+            while (libevdev_next_event(dev, LIBEVDEV_READ_FLAG_SYNC, &event)
+                   == LIBEVDEV_READ_STATUS_SYNC)
+                batch.push_back(event);
+    }
+
+    on_events(batch);
+}
+
+
+void
+EvdevSource::handle_raw_read()
+{
+    try {
+        on_events(raw_reader->read());
+    }
+    catch (std::system_error& e) {
+        if (e.code().value() == ENODEV)
+            fail(_("Device disconnected."));
+        else
+            fail(_("Input/output error."));
+    }
+}
+
+
+void
+EvdevSource::fail(const string& reason)
+{
+    stop();
+    on_stop(reason);
+}
+
+
+void
+EvdevSource::on_reader_ready()
+{
+    if (!reader)
+        return;
+
+    batch.clear();
+    input_event events[256];
+    while (auto count = reader->pop(events, std::size(events)))
+        batch.insert(batch.end(), events, events + count);
+
+    on_events(batch);
+
+    switch (reader->get_status()) {
+        case ReaderThread::Status::running:
+            break;
+        case ReaderThread::Status::disconnected:
+            fail(_("Device disconnected."));
+            break;
+        case ReaderThread::Status::error:
+            fail(_("Input/output error."));
+            break;
+    }
+}
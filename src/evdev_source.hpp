@@ -0,0 +1,154 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef EVDEV_SOURCE_HPP
+#define EVDEV_SOURCE_HPP
+
+#include <ctime>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <glibmm.h>
+#include <libevdevxx/Device.hpp>
+
+#include "input_source.hpp"
+#include "probe_pool.hpp"
+#include "reactor.hpp"
+#include "read_mode.hpp"
+
+
+class RawReader;
+class ReaderThread;
+
+
+// Reads a /dev/input/event* device.
+class EvdevSource : public InputSource {
+
+    std::filesystem::path dev_path;
+
+    std::unique_ptr<evdev::Device> device;
+
+    ReadMode read_mode;
+
+    clockid_t clock = CLOCK_REALTIME;
+
+    EventsSlot on_events;
+    StopSlot on_stop;
+
+    std::vector<input_event> batch;
+
+    Reactor& reactor;
+    Reactor::Id watch_id = 0;
+
+    std::unique_ptr<RawReader> raw_reader;
+
+    Glib::Dispatcher reader_dispatcher;
+    // Note: must be destroyed before reader_dispatcher.
+    std::unique_ptr<ReaderThread> reader;
+
+
+    void
+    on_io(std::uint32_t events);
+
+    void
+    handle_read();
+
+    void
+    handle_raw_read();
+
+    void
+    fail(const std::string& reason);
+
+    void
+    on_reader_ready();
+
+public:
+
+    // Takes ownership of the probed device.
+    EvdevSource(DeviceProbe&& probe,
+                ReadMode read_mode,
+                Reactor& reactor);
+
+    ~EvdevSource()
+        noexcept override;
+
+
+    std::string
+    get_path()
+        const override;
+
+    std::string
+    get_name()
+        const override;
+
+    std::uint16_t
+    get_vendor()
+        const override;
+
+    std::uint16_t
+    get_product()
+        const override;
+
+    std::uint16_t
+    get_version()
+        const override;
+
+
+    clockid_t
+    get_clock()
+        const noexcept override;
+
+
+    std::vector<evdev::Code>
+    get_abs_codes()
+        const override;
+
+    evdev::AbsInfo
+    get_abs_info(evdev::Code code)
+        const override;
+
+    void
+    set_abs_info(evdev::Code code,
+                 const evdev::AbsInfo& info)
+        override;
+
+    std::optional<int>
+    query_abs_value(evdev::Code code)
+        override;
+
+
+    bool
+    is_open()
+        const noexcept override;
+
+
+    void
+    start(EventsSlot on_events,
+          StopSlot on_stop)
+        override;
+
+    void
+    stop()
+        noexcept override;
+
+
+    bool
+    take_extremes(evdev::Code code,
+                  int& low,
+                  int& high,
+                  int& last)
+        noexcept override;
+
+    // Installs the mask in the kernel (EVIOCSMASK), so other types don't wake us up.
+    void
+    set_event_mask(const TypeMask& types)
+        override;
+
+}; // class EvdevSource
+
+#endif
@@ -0,0 +1,149 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef INPUT_SOURCE_HPP
+#define INPUT_SOURCE_HPP
+
+#include <bitset>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <linux/input.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+#include <libevdevxx/Code.hpp>
+
+
+/*
+ * Where a DevicePage gets its device identity, axes and events from.
+ *
+ * All methods, and all callbacks, run on the GUI thread.
+ */
+class InputSource {
+
+public:
+
+    // Receives a batch of raw events.
+    using EventsSlot = std::function<void(std::span<const input_event> events)>;
+
+    // Called once, when the source stops producing events.
+    using StopSlot = std::function<void(const std::string& reason)>;
+
+    // Set of event types (EV_*).
+    using TypeMask = std::bitset<EV_CNT>;
+
+
+    virtual
+    ~InputSource()
+        noexcept = default;
+
+
+    // Where the source comes from, to be shown to the user.
+    virtual
+    std::string
+    get_path()
+        const = 0;
+
+    virtual
+    std::string
+    get_name()
+        const = 0;
+
+    virtual
+    std::uint16_t
+    get_vendor()
+        const = 0;
+
+    virtual
+    std::uint16_t
+    get_product()
+        const = 0;
+
+    virtual
+    std::uint16_t
+    get_version()
+        const = 0;
+
+
+    // The clock of the event timestamps.
+    virtual
+    clockid_t
+    get_clock()
+        const noexcept = 0;
+
+
+    virtual
+    std::vector<evdev::Code>
+    get_abs_codes()
+        const = 0;
+
+    virtual
+    evdev::AbsInfo
+    get_abs_info(evdev::Code code)
+        const = 0;
+
+    virtual
+    void
+    set_abs_info(evdev::Code code,
+                 const evdev::AbsInfo& info) = 0;
+
+    // Query the current value of an axis, bypassing any event queue.
+    virtual
+    std::optional<int>
+    query_abs_value(evdev::Code code) = 0;
+
+
+    virtual
+    bool
+    is_open()
+        const noexcept = 0;
+
+
+    virtual
+    void
+    start(EventsSlot on_events,
+          StopSlot on_stop) = 0;
+
+    virtual
+    void
+    stop()
+        noexcept = 0;
+
+
+    /*
+     * Extremes for an axis, that might have been seen by the source without being
+     * delivered as events. Returns false if there's nothing new.
+     */
+    virtual
+    bool
+    take_extremes(evdev::Code /* code */,
+                  int& /* low */,
+                  int& /* high */,
+                  int& /* last */)
+        noexcept
+    {
+        return false;
+    }
+
+
+    /*
+     * Hint that only these event types are needed. EV_SYN is always delivered. Other
+     * types may still be delivered, and must be ignored.
+     */
+    virtual
+    void
+    set_event_mask(const TypeMask& /* types */)
+    {}
+
+}; // class InputSource
+
+#endif
@@ -0,0 +1,106 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <utility>
+
+#include <libevdevxx/Event.hpp>
+
+#include "overview_canvas.hpp"
+
+#include "redraw_scheduler.hpp"
+
+
+using evdev::AbsInfo;
+using evdev::Code;
+
+
+OverviewCanvas::OverviewCanvas(ActivateSlot on_activate_) :
+    on_activate{std::move(on_activate_)}
+{
+    set_hexpand(true);
+    add_events(Gdk::BUTTON_PRESS_MASK);
+}
+
+
+OverviewCanvas::~OverviewCanvas()
+    noexcept
+{
+    RedrawScheduler::get().cancel(*this);
+}
+
+
+bool
+OverviewCanvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+{
+    renderer.draw(cr, get_allocated_width());
+    return true;
+}
+
+
+bool
+OverviewCanvas::on_button_press_event(GdkEventButton* event)
+{
+    if (event->type != GDK_BUTTON_PRESS || event->button != 1)
+        return false;
+    if (auto row = renderer.row_at(event->y))
+        on_activate(row->code);
+    return true;
+}
+
+
+OverviewCanvas::Row&
+OverviewCanvas::add_row(Code code,
+                        const AbsInfo& orig)
+{
+    auto& row = renderer.add_row(code,
+                                 evdev::code_to_string(evdev::Type::abs, code),
+                                 orig);
+    set_size_request(-1, renderer.get_height());
+    schedule_draw();
+    return row;
+}
+
+
+OverviewCanvas::Row*
+OverviewCanvas::find_row(Code code)
+    noexcept
+{
+    return renderer.find_row(code);
+}
+
+
+void
+OverviewCanvas::set_row_hidden(Code code,
+                               bool hidden)
+{
+    renderer.set_hidden(code, hidden);
+    set_size_request(-1, renderer.get_height());
+    schedule_draw();
+}
+
+
+void
+OverviewCanvas::schedule_draw()
+{
+    RedrawScheduler::get().queue_draw(*this);
+}
+
+
+void
+OverviewCanvas::set_selected(std::optional<Code> code)
+{
+    renderer.set_selected(code);
+    schedule_draw();
+}
+
+
+void
+OverviewCanvas::set_colors(const Colors& c)
+{
+    renderer.set_colors(c);
+    schedule_draw();
+}
@@ -0,0 +1,84 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef OVERVIEW_CANVAS_HPP
+#define OVERVIEW_CANVAS_HPP
+
+#include <functional>
+#include <optional>
+
+#include <gtkmm.h>
+#include <cairomm/cairomm.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+#include <libevdevxx/Code.hpp>
+
+#include "colors.hpp"
+#include "overview_renderer.hpp"
+
+
+// Shows every axis of a device in a single widget; clicking a row selects it.
+class OverviewCanvas : public Gtk::DrawingArea {
+public:
+
+    using Row = OverviewRenderer::Row;
+
+    using ActivateSlot = std::function<void(evdev::Code code)>;
+
+private:
+
+    OverviewRenderer renderer;
+
+    ActivateSlot on_activate;
+
+
+    bool
+    on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+        override;
+
+    bool
+    on_button_press_event(GdkEventButton* event)
+        override;
+
+public:
+
+    explicit
+    OverviewCanvas(ActivateSlot on_activate);
+
+    ~OverviewCanvas()
+        noexcept override;
+
+
+    Row&
+    add_row(evdev::Code code,
+            const evdev::AbsInfo& orig);
+
+    // Returns nullptr if there's no such row. Call schedule_draw() after changing it.
+    Row*
+    find_row(evdev::Code code)
+        noexcept;
+
+    // Hidden rows take no space.
+    void
+    set_row_hidden(evdev::Code code,
+                   bool hidden);
+
+    // Redraws on the next frame, through the RedrawScheduler.
+    void
+    schedule_draw();
+
+
+    void
+    set_selected(std::optional<evdev::Code> code);
+
+
+    void
+    set_colors(const Colors& c);
+
+}; // class OverviewCanvas
+
+#endif
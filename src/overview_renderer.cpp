@@ -0,0 +1,242 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "overview_renderer.hpp"
+
+
+using evdev::AbsInfo;
+using evdev::Code;
+
+
+namespace {
+
+    const double name_width = 150;
+    const double bar_margin = 8;
+    const double bar_height = 12;
+
+
+    void
+    set_color(const Cairo::RefPtr<Cairo::Context>& ctx,
+              const Gdk::RGBA& color)
+    {
+        ctx->set_source_rgba(color.get_red(),
+                             color.get_green(),
+                             color.get_blue(),
+                             color.get_alpha());
+    }
+
+
+    // Maps axis values to the horizontal extent of the bar.
+    struct BarMap {
+
+        double left;
+        double right;
+        double low;
+        double high;
+
+        BarMap(const OverviewRenderer::Row& row,
+               double width) :
+            left{name_width},
+            right{width - bar_margin},
+            low(std::min(row.orig.min, row.calc.min)),
+            high(std::max(row.orig.max, row.calc.max))
+        {}
+
+        double
+        operator ()(double value)
+            const noexcept
+        {
+            if (high <= low)
+                return std::round((left + right) / 2);
+            return std::round(left + (right - left) * (value - low) / (high - low));
+        }
+
+    };
+
+} // namespace
+
+
+OverviewRenderer::Row&
+OverviewRenderer::add_row(Code code,
+                          const std::string& name,
+                          const AbsInfo& orig)
+{
+    index[code] = rows.size();
+    shown.push_back(rows.size());
+    auto& row = rows.emplace_back(code, name, orig, orig);
+    row.calc.min = row.calc.max = orig.val;
+    return row;
+}
+
+
+OverviewRenderer::Row*
+OverviewRenderer::find_row(Code code)
+    noexcept
+{
+    auto i = index.find(code);
+    return i ? &rows[*i] : nullptr;
+}
+
+
+const OverviewRenderer::Row*
+OverviewRenderer::row_at(double y)
+    const noexcept
+{
+    if (y < 0)
+        return nullptr;
+    auto pos = static_cast<std::size_t>(y / row_height);
+    if (pos >= shown.size())
+        return nullptr;
+    return &rows[shown[pos]];
+}
+
+
+void
+OverviewRenderer::set_hidden(Code code,
+                             bool hidden)
+{
+    auto row = find_row(code);
+    if (!row || row->hidden == hidden)
+        return;
+    row->hidden = hidden;
+
+    shown.clear();
+    for (std::size_t i = 0; i < rows.size(); ++i)
+        if (!rows[i].hidden)
+            shown.push_back(i);
+}
+
+
+double
+OverviewRenderer::get_height()
+    const noexcept
+{
+    return shown.size() * row_height;
+}
+
+
+void
+OverviewRenderer::set_selected(std::optional<Code> code)
+{
+    selected = code;
+}
+
+
+void
+OverviewRenderer::set_colors(const Colors& c)
+{
+    colors = c;
+}
+
+
+void
+OverviewRenderer::draw(const Cairo::RefPtr<Cairo::Context>& cr,
+                       double width)
+    const
+{
+    set_color(cr, colors.background);
+    cr->paint();
+
+    // Only the rows inside the clip area need to be drawn.
+    double x1, y1, x2, y2;
+    cr->get_clip_extents(x1, y1, x2, y2);
+    const auto first = static_cast<std::size_t>(std::max(0.0, y1 / row_height));
+    const auto last = std::min(shown.size(),
+                               static_cast<std::size_t>(std::ceil(y2 / row_height)));
+    if (first >= last)
+        return;
+
+    auto bar_top = [](std::size_t i)
+    {
+        return i * row_height + (row_height - bar_height) / 2;
+    };
+
+    // The i-th row from the top.
+    auto row_at_pos = [this](std::size_t i) -> const Row&
+    {
+        return rows[shown[i]];
+    };
+
+    // Selection highlight.
+    for (std::size_t i = first; i < last; ++i)
+        if (selected && row_at_pos(i).code == *selected)
+            cr->rectangle(0, i * row_height, width, row_height);
+    cr->set_source_rgba(colors.value.get_red(),
+                        colors.value.get_green(),
+                        colors.value.get_blue(),
+                        0.15);
+    cr->fill();
+
+    // Flat regions.
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& row = row_at_pos(i);
+        if (row.calc.flat <= 0)
+            continue;
+        BarMap map{row, width};
+        const double center = row.flat_centered
+            ? (std::int64_t{row.calc.min} + row.calc.max) / 2.0
+            : 0.0;
+        const double a = map(center - row.calc.flat);
+        const double b = map(center + row.calc.flat);
+        cr->rectangle(a, bar_top(i), std::max(1.0, b - a), bar_height);
+    }
+    set_color(cr, colors.flat);
+    cr->fill();
+
+    cr->set_line_width(1);
+
+    // Calc limits: min on the left, max on the right.
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& row = row_at_pos(i);
+        BarMap map{row, width};
+        cr->move_to(map(row.calc.min) + 0.5, bar_top(i));
+        cr->rel_line_to(0, bar_height);
+    }
+    set_color(cr, colors.min);
+    cr->stroke();
+
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& row = row_at_pos(i);
+        BarMap map{row, width};
+        cr->move_to(map(row.calc.max) + 0.5, bar_top(i));
+        cr->rel_line_to(0, bar_height);
+    }
+    set_color(cr, colors.max);
+    cr->stroke();
+
+    // Orig range, as a baseline.
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& row = row_at_pos(i);
+        BarMap map{row, width};
+        const double y = bar_top(i) + bar_height / 2 + 0.5;
+        cr->move_to(map(row.orig.min), y);
+        cr->line_to(map(row.orig.max) + 1, y);
+    }
+    set_color(cr, colors.fuzz);
+    cr->stroke();
+
+    // Values.
+    for (std::size_t i = first; i < last; ++i) {
+        const auto& row = row_at_pos(i);
+        BarMap map{row, width};
+        cr->rectangle(map(row.calc.val) - 1, bar_top(i) - 2, 3, bar_height + 4);
+    }
+    set_color(cr, colors.value);
+    cr->fill();
+
+    // Names.
+    cr->select_font_face("monospace", Cairo::FONT_SLANT_NORMAL, Cairo::FONT_WEIGHT_BOLD);
+    cr->set_font_size(11);
+    for (std::size_t i = first; i < last; ++i) {
+        cr->move_to(bar_margin, (i + 1) * row_height - 6);
+        cr->show_text(row_at_pos(i).name);
+    }
+}
@@ -0,0 +1,100 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef OVERVIEW_RENDERER_HPP
+#define OVERVIEW_RENDERER_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <cairomm/cairomm.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+#include <libevdevxx/Code.hpp>
+
+#include "axis_table.hpp"
+#include "colors.hpp"
+
+
+/*
+ * Draws every axis of a device as a compact row: name, calc range, flat and value.
+ *
+ * All rows are drawn in one pass, grouped by color, and rows outside the clip area are
+ * skipped; so a device with dozens of axes costs one widget, not hundreds.
+ */
+class OverviewRenderer {
+public:
+
+    static constexpr double row_height = 20;
+
+    struct Row {
+        evdev::Code code;
+        std::string name;
+        evdev::AbsInfo orig;
+        evdev::AbsInfo calc;
+        bool flat_centered = false;
+        bool hidden = false;
+    };
+
+private:
+
+    std::vector<Row> rows;
+    // Position of each code in rows.
+    AxisTable<std::size_t> index;
+    // Positions in rows of the rows that are not hidden, from top to bottom.
+    std::vector<std::size_t> shown;
+
+    std::optional<evdev::Code> selected;
+
+    Colors colors;
+
+public:
+
+    // Calc starts as an empty range around the current value.
+    Row&
+    add_row(evdev::Code code,
+            const std::string& name,
+            const evdev::AbsInfo& orig);
+
+    // Returns nullptr if there's no such row.
+    Row*
+    find_row(evdev::Code code)
+        noexcept;
+
+    // Returns the row at this vertical position, or nullptr.
+    const Row*
+    row_at(double y)
+        const noexcept;
+
+    // Hidden rows take no space.
+    void
+    set_hidden(evdev::Code code,
+               bool hidden);
+
+
+    double
+    get_height()
+        const noexcept;
+
+
+    void
+    set_selected(std::optional<evdev::Code> code);
+
+
+    void
+    set_colors(const Colors& c);
+
+
+    void
+    draw(const Cairo::RefPtr<Cairo::Context>& cr,
+         double width)
+        const;
+
+}; // class OverviewRenderer
+
+#endif
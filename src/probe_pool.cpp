@@ -0,0 +1,101 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+#include "probe_pool.hpp"
+
+
+using std::filesystem::path;
+
+
+ProbePool::ProbePool(Slot on_done,
+                     unsigned max_threads) :
+    on_done{std::move(on_done)},
+    max_threads{std::max(1u, max_threads)}
+{
+    dispatcher.connect(sigc::mem_fun(this, &ProbePool::on_dispatch));
+}
+
+
+ProbePool::~ProbePool()
+    noexcept
+{
+    {
+        std::lock_guard guard{mutex};
+        stopping = true;
+        jobs.clear();
+    }
+    cond.notify_all();
+
+    // Note: a worker stuck opening a device will delay this.
+    for (auto& t : threads)
+        t.join();
+}
+
+
+void
+ProbePool::submit(const path& dev_path,
+                  std::uint64_t token)
+{
+    {
+        std::lock_guard guard{mutex};
+        jobs.push_back(DeviceProbe{dev_path, token, nullptr, {}});
+        if (idle >= jobs.size() || threads.size() >= max_threads) {
+            cond.notify_one();
+            return;
+        }
+    }
+    // Threads are only created when there are more jobs than idle threads.
+    threads.emplace_back(&ProbePool::run, this);
+}
+
+
+void
+ProbePool::run()
+    noexcept
+{
+    std::unique_lock lock{mutex};
+    for (;;) {
+        ++idle;
+        cond.wait(lock, [this] { return stopping || !jobs.empty(); });
+        --idle;
+        if (stopping)
+            return;
+
+        DeviceProbe probe = std::move(jobs.front());
+        jobs.pop_front();
+        lock.unlock();
+
+        try {
+            probe.device = std::make_unique<evdev::Device>(probe.dev_path);
+        }
+        catch (std::exception& e) {
+            probe.error = e.what();
+        }
+
+        lock.lock();
+        results.push_back(std::move(probe));
+        dispatcher.emit();
+    }
+}
+
+
+void
+ProbePool::on_dispatch()
+{
+    std::vector<DeviceProbe> done;
+    {
+        std::lock_guard guard{mutex};
+        std::swap(done, results);
+    }
+
+    for (auto& probe : done)
+        on_done(probe);
+}
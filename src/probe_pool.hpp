@@ -0,0 +1,91 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef PROBE_POOL_HPP
+#define PROBE_POOL_HPP
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glibmm.h>
+#include <libevdevxx/Device.hpp>
+
+
+// An opened device, ready to be handed to an EvdevSource.
+struct DeviceProbe {
+    std::filesystem::path dev_path;
+    // Given to submit(), identifies the request.
+    std::uint64_t token = 0;
+    std::unique_ptr<evdev::Device> device;
+    // Set if the device could not be opened.
+    std::string error;
+};
+
+
+/*
+ * Opens devices on worker threads, so slow devices don't block the GUI.
+ *
+ * Results are delivered on the GUI thread, in the order they finish.
+ */
+class ProbePool {
+
+public:
+
+    using Slot = std::function<void(DeviceProbe& probe)>;
+
+private:
+
+    Slot on_done;
+
+    unsigned max_threads;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    // Probes not started yet, only with dev_path and token set.
+    std::deque<DeviceProbe> jobs;
+    std::vector<DeviceProbe> results;
+    unsigned idle = 0;
+    bool stopping = false;
+
+    Glib::Dispatcher dispatcher;
+
+    // Note: must be destroyed before everything else.
+    std::vector<std::thread> threads;
+
+
+    void
+    run()
+        noexcept;
+
+    void
+    on_dispatch();
+
+public:
+
+    explicit
+    ProbePool(Slot on_done,
+              unsigned max_threads = 8);
+
+    ~ProbePool()
+        noexcept;
+
+
+    void
+    submit(const std::filesystem::path& dev_path,
+           std::uint64_t token);
+
+}; // class ProbePool
+
+#endif
@@ -0,0 +1,33 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <system_error>
+
+#include <unistd.h>
+
+#include "raw_reader.hpp"
+
+
+RawReader::RawReader(int fd,
+                     std::size_t capacity) :
+    fd{fd},
+    buffer(capacity)
+{}
+
+
+std::span<const input_event>
+RawReader::read()
+{
+    ssize_t r = ::read(fd, buffer.data(), buffer.size() * sizeof(input_event));
+    if (r < 0) {
+        if (errno == EAGAIN || errno == EINTR)
+            return {};
+        throw std::system_error{errno, std::system_category(), "read()"};
+    }
+    return {buffer.data(), r / sizeof(input_event)};
+}
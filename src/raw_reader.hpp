@@ -0,0 +1,44 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef RAW_READER_HPP
+#define RAW_READER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <linux/input.h>
+
+
+/*
+ * Reads evdev events in bulk: a single read(2) call fills an array of input_event, that
+ * is used in place, without any per-event allocation or conversion.
+ */
+class RawReader {
+
+    int fd;
+
+    std::vector<input_event> buffer;
+
+public:
+
+    explicit
+    RawReader(int fd,
+              std::size_t capacity = 1024);
+
+
+    /*
+     * Returns the events read, which are valid until the next call. Returns an empty
+     * span if there was nothing to read. Throws std::system_error on errors.
+     */
+    std::span<const input_event>
+    read();
+
+}; // class RawReader
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include "reactor.hpp"
+
+
+using std::cerr;
+using std::endl;
+
+using Glib::IOCondition;
+
+
+namespace {
+
+    // How many ready fds are handled in one dispatch; any more wait for the next one.
+    constexpr int max_ready = 64;
+
+} // namespace
+
+
+Reactor::Reactor() :
+    epoll_fd{epoll_create1(EPOLL_CLOEXEC)}
+{
+    if (epoll_fd < 0)
+        throw std::system_error{errno, std::system_category(), "epoll_create1()"};
+}
+
+
+Reactor::~Reactor()
+    noexcept
+{
+    io_conn.disconnect();
+    close(epoll_fd);
+}
+
+
+Reactor::Id
+Reactor::add(int fd,
+             Slot slot)
+{
+    const Id id = next_id++;
+
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.u64 = id;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+        throw std::system_error{errno, std::system_category(), "epoll_ctl()"};
+
+    watches.emplace(id, Watch{fd, std::move(slot)});
+
+    if (!io_conn.connected())
+        io_conn = Glib::signal_io().connect(sigc::mem_fun(this, &Reactor::on_io),
+                                            epoll_fd,
+                                            IOCondition::IO_IN);
+    return id;
+}
+
+
+void
+Reactor::remove(Id id)
+    noexcept
+{
+    auto it = watches.find(id);
+    if (it == watches.end())
+        return;
+
+    // The fd might be already closed, so failure here is harmless.
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+
+    if (dispatching) {
+        it->second.removed = true;
+        return;
+    }
+
+    watches.erase(it);
+    if (watches.empty())
+        io_conn.disconnect();
+}
+
+
+bool
+Reactor::on_io(IOCondition)
+{
+    epoll_event ready[max_ready];
+    int n = epoll_wait(epoll_fd, ready, max_ready, 0);
+    if (n < 0) {
+        if (errno != EINTR)
+            cerr << "epoll_wait() failed: " << std::system_category().message(errno) << endl;
+        return true;
+    }
+
+    dispatching = true;
+    for (int i = 0; i < n; ++i) {
+        auto it = watches.find(ready[i].data.u64);
+        if (it == watches.end() || it->second.removed)
+            continue;
+        it->second.slot(ready[i].events);
+    }
+    dispatching = false;
+
+    std::erase_if(watches, [](const auto& entry) { return entry.second.removed; });
+    if (watches.empty()) {
+        io_conn.disconnect();
+        return false;
+    }
+
+    return true;
+}
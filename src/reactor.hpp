@@ -0,0 +1,77 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef REACTOR_HPP
+#define REACTOR_HPP
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+#include <glibmm.h>
+
+
+/*
+ * Watches many file descriptors through a single epoll instance.
+ *
+ * Only the epoll fd is watched by the GLib main loop, so a single dispatch handles every
+ * ready fd, no matter how many are registered.
+ */
+class Reactor {
+
+public:
+
+    // Receives the epoll event mask (EPOLLIN, EPOLLERR, EPOLLHUP).
+    using Slot = std::function<void(std::uint32_t events)>;
+
+    using Id = std::uint64_t;
+
+private:
+
+    struct Watch {
+        int fd;
+        Slot slot;
+        bool removed = false;
+    };
+
+    int epoll_fd = -1;
+
+    sigc::connection io_conn;
+
+    // Keyed by registration id, so a reused fd never reaches a stale slot.
+    std::unordered_map<Id, Watch> watches;
+    Id next_id = 1;
+
+    // While dispatching, removed watches are only erased at the end.
+    bool dispatching = false;
+
+
+    bool
+    on_io(Glib::IOCondition cond);
+
+public:
+
+    Reactor();
+
+    ~Reactor()
+        noexcept;
+
+    Reactor(const Reactor&) = delete;
+
+
+    Id
+    add(int fd,
+        Slot slot);
+
+    // Safe to call from inside a slot.
+    void
+    remove(Id id)
+        noexcept;
+
+}; // class Reactor
+
+#endif
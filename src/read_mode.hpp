@@ -0,0 +1,37 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef READ_MODE_HPP
+#define READ_MODE_HPP
+
+#include <optional>
+#include <string_view>
+
+
+// How a DevicePage reads events from its device.
+enum class ReadMode {
+    libevdev, // on the GUI thread, through libevdevxx
+    raw,      // on the GUI thread, with a single read(2) per wakeup
+    thread,   // on a dedicated thread, handed to the GUI through a ring buffer
+};
+
+
+inline
+std::optional<ReadMode>
+parse_read_mode(std::string_view name)
+    noexcept
+{
+    if (name == "libevdev")
+        return ReadMode::libevdev;
+    if (name == "raw")
+        return ReadMode::raw;
+    if (name == "thread")
+        return ReadMode::thread;
+    return {};
+}
+
+#endif
@@ -0,0 +1,193 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <cerrno>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "reader_thread.hpp"
+
+
+namespace {
+
+    void
+    atomic_min(std::atomic<int>& target,
+               int value)
+        noexcept
+    {
+        int old = target.load(std::memory_order_relaxed);
+        while (value < old &&
+               !target.compare_exchange_weak(old, value, std::memory_order_relaxed))
+            ;
+    }
+
+
+    void
+    atomic_max(std::atomic<int>& target,
+               int value)
+        noexcept
+    {
+        int old = target.load(std::memory_order_relaxed);
+        while (value > old &&
+               !target.compare_exchange_weak(old, value, std::memory_order_relaxed))
+            ;
+    }
+
+} // namespace
+
+
+ReaderThread::ReaderThread(int fd,
+                           std::function<void()> notify) :
+    fd{fd},
+    notify{std::move(notify)}
+{
+    stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (stop_fd < 0)
+        throw std::system_error{errno, std::system_category(), "eventfd()"};
+
+    try {
+        thread = std::thread{&ReaderThread::run, this};
+    }
+    catch (...) {
+        close(stop_fd);
+        throw;
+    }
+}
+
+
+ReaderThread::~ReaderThread()
+    noexcept
+{
+    std::uint64_t one = 1;
+    if (write(stop_fd, &one, sizeof one) < 0)
+        std::terminate(); // the thread would never stop
+
+    if (thread.joinable())
+        thread.join();
+    close(stop_fd);
+}
+
+
+void
+ReaderThread::run()
+    noexcept
+{
+    input_event buf[64];
+
+    pollfd fds[2] = {
+        { fd,      POLLIN, 0 },
+        { stop_fd, POLLIN, 0 },
+    };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            status = Status::error;
+            break;
+        }
+
+        if (fds[1].revents)
+            return;
+
+        if (fds[0].revents & (POLLHUP | POLLERR)) {
+            status = Status::disconnected;
+            break;
+        }
+
+        ssize_t r = read(fd, buf, sizeof buf);
+        if (r < 0) {
+            if (errno == EINTR || errno == EAGAIN)
+                continue;
+            status = errno == ENODEV ? Status::disconnected : Status::error;
+            break;
+        }
+
+        process(buf, r / sizeof(input_event));
+    }
+
+    // Let the consumer know about the status change.
+    notify();
+}
+
+
+void
+ReaderThread::process(const input_event* events,
+                      std::size_t count)
+    noexcept
+{
+    if (!count)
+        return;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& event = events[i];
+
+        if (event.type == EV_ABS && event.code < ABS_CNT) {
+            auto& ext = extremes[event.code];
+            atomic_min(ext.low, event.value);
+            atomic_max(ext.high, event.value);
+            ext.last.store(event.value, std::memory_order_relaxed);
+        }
+
+        if (ring_overflowed) {
+            input_event dropped = event;
+            dropped.type = EV_SYN;
+            dropped.code = SYN_DROPPED;
+            dropped.value = 0;
+            if (!ring.push(dropped))
+                continue;
+            ring_overflowed = false;
+        }
+
+        if (!ring.push(event))
+            ring_overflowed = true;
+    }
+
+    if (!notified.exchange(true))
+        notify();
+}
+
+
+std::size_t
+ReaderThread::pop(input_event* events,
+                  std::size_t max_events)
+    noexcept
+{
+    // Clear the flag before popping, so the next push is guaranteed to notify again.
+    notified = false;
+    return ring.pop(events, max_events);
+}
+
+
+bool
+ReaderThread::take_extremes(std::uint16_t code,
+                            int& low,
+                            int& high,
+                            int& last)
+    noexcept
+{
+    if (code >= ABS_CNT)
+        return false;
+    auto& ext = extremes[code];
+    low  = ext.low.exchange(INT_MAX, std::memory_order_relaxed);
+    high = ext.high.exchange(INT_MIN, std::memory_order_relaxed);
+    last = ext.last.load(std::memory_order_relaxed);
+    return low != INT_MAX || high != INT_MIN;
+}
+
+
+ReaderThread::Status
+ReaderThread::get_status()
+    const noexcept
+{
+    return status.load();
+}
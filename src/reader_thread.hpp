@@ -0,0 +1,111 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef READER_THREAD_HPP
+#define READER_THREAD_HPP
+
+#include <array>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#include <linux/input.h>
+
+#include "spsc_ring.hpp"
+
+
+/*
+ * Drains an evdev file descriptor from a dedicated thread, into a ring buffer that is
+ * consumed by the GUI thread.
+ *
+ * Independently of the ring, the thread also keeps the extremes of every axis, so the
+ * min/max capture is exact even if the ring overflows while the GUI is blocked.
+ *
+ * A ring overflow is reported to the consumer the same way the kernel reports a buffer
+ * overflow: with a SYN_DROPPED event.
+ */
+class ReaderThread {
+
+public:
+
+    using Ring = SPSCRing<input_event, 4096>;
+
+    enum class Status {
+        running,
+        disconnected,
+        error
+    };
+
+private:
+
+    struct Extremes {
+        std::atomic<int> low  = INT_MAX;
+        std::atomic<int> high = INT_MIN;
+        std::atomic<int> last = 0;
+    };
+
+    int fd;
+    int stop_fd = -1;
+
+    // Called from the reader thread, when the ring goes from empty to non-empty.
+    std::function<void()> notify;
+    std::atomic<bool> notified = false;
+
+    Ring ring;
+    // Set when an event didn't fit in the ring; a SYN_DROPPED must be pushed next.
+    bool ring_overflowed = false;
+    std::array<Extremes, ABS_CNT> extremes;
+    std::atomic<Status> status = Status::running;
+
+    std::thread thread;
+
+
+    void
+    run()
+        noexcept;
+
+    void
+    process(const input_event* events,
+            std::size_t count)
+        noexcept;
+
+public:
+
+    ReaderThread(int fd,
+                 std::function<void()> notify);
+
+    ~ReaderThread()
+        noexcept;
+
+
+    // Pops up to max_events from the ring. Call only from the consumer thread.
+    std::size_t
+    pop(input_event* events,
+        std::size_t max_events)
+        noexcept;
+
+    /*
+     * Collects the extremes seen by the reader thread since the last call, for axis
+     * `code`. Returns false if the axis didn't change.
+     */
+    bool
+    take_extremes(std::uint16_t code,
+                  int& low,
+                  int& high,
+                  int& last)
+        noexcept;
+
+    Status
+    get_status()
+        const noexcept;
+
+}; // class ReaderThread
+
+#endif
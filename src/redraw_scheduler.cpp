@@ -0,0 +1,99 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "redraw_scheduler.hpp"
+
+
+RedrawScheduler&
+RedrawScheduler::get()
+{
+    // Note: never destroyed, so widgets can still cancel during shutdown.
+    static auto instance = new RedrawScheduler;
+    return *instance;
+}
+
+
+void
+RedrawScheduler::queue_draw(Gtk::Widget& widget)
+{
+    // Unmapped widgets (e.g. on other notebook pages) are fully drawn when mapped.
+    if (!widget.get_mapped())
+        return;
+
+    if (std::find(dirty.begin(), dirty.end(), &widget) == dirty.end())
+        dirty.push_back(&widget);
+
+    // A window that isn't shown won't tick; move to this widget's window.
+    if (clock_widget && !clock_widget->get_mapped())
+        clock_widget->remove_tick_callback(tick_id);
+
+    if (!clock_widget)
+        arm(widget);
+}
+
+
+void
+RedrawScheduler::cancel(Gtk::Widget& widget)
+    noexcept
+{
+    std::erase(dirty, &widget);
+}
+
+
+void
+RedrawScheduler::set_max_fps(unsigned fps)
+    noexcept
+{
+    max_fps = fps;
+}
+
+
+void
+RedrawScheduler::arm(Gtk::Widget& widget)
+{
+    auto top = widget.get_toplevel();
+    // Not shown yet; it will be fully drawn when it is.
+    if (!top || !top->get_realized())
+        return;
+
+    // Clears clock_widget when GTK drops the callback, for whatever reason.
+    std::shared_ptr<void> guard{nullptr,
+                                [this](void*)
+                                {
+                                    clock_widget = nullptr;
+                                    tick_id = 0;
+                                }};
+    clock_widget = top;
+    tick_id = top->add_tick_callback([this, guard](const Glib::RefPtr<Gdk::FrameClock>& clock)
+    {
+        return on_tick(clock);
+    });
+}
+
+
+bool
+RedrawScheduler::on_tick(const Glib::RefPtr<Gdk::FrameClock>& clock)
+{
+    if (max_fps) {
+        const gint64 now = clock->get_frame_time();
+        if (now - last_push < 1'000'000 / max_fps)
+            return true; // wait for a later frame
+        last_push = now;
+    }
+
+    auto widgets = std::move(dirty);
+    dirty.clear();
+    for (auto widget : widgets)
+        widget->queue_draw();
+
+    // Re-armed by the next queue_draw().
+    return false;
+}
@@ -0,0 +1,68 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef REDRAW_SCHEDULER_HPP
+#define REDRAW_SCHEDULER_HPP
+
+#include <vector>
+
+#include <gtkmm.h>
+
+
+/*
+ * Collects widgets that need to be redrawn, and redraws them all at once, from the
+ * frame clock of a window; so no matter how often values change, each widget is
+ * redrawn at most once per frame.
+ *
+ * Optionally, redraws can be limited to a lower rate than the display's.
+ */
+class RedrawScheduler {
+
+    std::vector<Gtk::Widget*> dirty;
+
+    // The window whose frame clock will push the redraws.
+    Gtk::Widget* clock_widget = nullptr;
+    guint tick_id = 0;
+
+    unsigned max_fps = 0;
+    gint64 last_push = 0;
+
+
+    RedrawScheduler() = default;
+
+
+    void
+    arm(Gtk::Widget& widget);
+
+    bool
+    on_tick(const Glib::RefPtr<Gdk::FrameClock>& clock);
+
+public:
+
+    static
+    RedrawScheduler&
+    get();
+
+
+    // Use this instead of widget.queue_draw().
+    void
+    queue_draw(Gtk::Widget& widget);
+
+    // Must be called when the widget is destroyed.
+    void
+    cancel(Gtk::Widget& widget)
+        noexcept;
+
+
+    // Zero means no limit, other than the display's refresh rate.
+    void
+    set_max_fps(unsigned fps)
+        noexcept;
+
+}; // class RedrawScheduler
+
+#endif
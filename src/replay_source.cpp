@@ -0,0 +1,268 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <utility>
+
+#include "replay_source.hpp"
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <glibmm/i18n.h>
+
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::filesystem::path;
+using std::string;
+
+using evdev::AbsInfo;
+using evdev::Code;
+
+
+namespace {
+
+    // How many events to deliver per idle callback, when replaying as fast as possible.
+    constexpr std::size_t fast_batch_size = 4096;
+
+} // namespace
+
+
+ReplaySource::ReplaySource(const path& cap_path,
+                           double speed) :
+    cap_path{cap_path},
+    reader{cap_path},
+    speed{speed}
+{
+    for (const auto& [code, info] : reader.get_header().axes)
+        abs[Code{code}] = info;
+
+    advance();
+}
+
+
+ReplaySource::~ReplaySource()
+    noexcept
+{
+    stop();
+}
+
+
+string
+ReplaySource::get_path()
+    const
+{
+    return cap_path.string();
+}
+
+
+string
+ReplaySource::get_name()
+    const
+{
+    return reader.get_header().name;
+}
+
+
+std::uint16_t
+ReplaySource::get_vendor()
+    const
+{
+    return reader.get_header().vendor;
+}
+
+
+std::uint16_t
+ReplaySource::get_product()
+    const
+{
+    return reader.get_header().product;
+}
+
+
+std::uint16_t
+ReplaySource::get_version()
+    const
+{
+    return reader.get_header().version;
+}
+
+
+clockid_t
+ReplaySource::get_clock()
+    const noexcept
+{
+    return reader.get_header().clock;
+}
+
+
+std::vector<Code>
+ReplaySource::get_abs_codes()
+    const
+{
+    std::vector<Code> result;
+    for (const auto& [code, _] : abs)
+        result.push_back(code);
+    return result;
+}
+
+
+AbsInfo
+ReplaySource::get_abs_info(Code code)
+    const
+{
+    return abs.at(code);
+}
+
+
+void
+ReplaySource::set_abs_info(Code code,
+                           const AbsInfo& info)
+{
+    abs[code] = info;
+}
+
+
+std::optional<int>
+ReplaySource::query_abs_value(Code code)
+{
+    auto it = abs.find(code);
+    if (it == abs.end())
+        return {};
+    return it->second.val;
+}
+
+
+bool
+ReplaySource::is_open()
+    const noexcept
+{
+    return true;
+}
+
+
+void
+ReplaySource::start(EventsSlot on_events_,
+                    StopSlot on_stop_)
+{
+    on_events = std::move(on_events_);
+    on_stop = std::move(on_stop_);
+
+    start_wall_time = g_get_monotonic_time();
+    if (has_next)
+        start_event_time = Capture::event_time(next_event);
+
+    if (speed <= 0)
+        timer_conn = Glib::signal_idle().connect(sigc::mem_fun(this, &ReplaySource::on_idle));
+    else
+        schedule();
+}
+
+
+void
+ReplaySource::stop()
+    noexcept
+{
+    timer_conn.disconnect();
+}
+
+
+void
+ReplaySource::advance()
+{
+    try {
+        has_next = reader.next(next_event);
+    }
+    catch (std::exception& e) {
+        cerr << "Error reading " << cap_path << ": " << e.what() << endl;
+        has_next = false;
+    }
+}
+
+
+void
+ReplaySource::deliver(const input_event& event)
+{
+    batch.push_back(event);
+    ++total_events;
+
+    if (event.type == EV_ABS)
+        if (auto it = abs.find(Code{event.code}); it != abs.end())
+            it->second.val = event.value;
+}
+
+
+void
+ReplaySource::schedule()
+{
+    if (!has_next) {
+        finish();
+        return;
+    }
+
+    const std::int64_t offset = Capture::event_time(next_event) - start_event_time;
+    const std::int64_t due = start_wall_time + static_cast<std::int64_t>(offset / speed);
+    const std::int64_t delay = std::max<std::int64_t>(0, due - g_get_monotonic_time());
+
+    // Round up, so the timer doesn't fire before the event is due.
+    timer_conn = Glib::signal_timeout().connect(sigc::mem_fun(this, &ReplaySource::on_timer),
+                                                (delay + 999) / 1000);
+}
+
+
+bool
+ReplaySource::on_timer()
+{
+    const std::int64_t elapsed = g_get_monotonic_time() - start_wall_time;
+    const std::int64_t replay_time = start_event_time + static_cast<std::int64_t>(elapsed * speed);
+
+    batch.clear();
+    while (has_next && Capture::event_time(next_event) <= replay_time) {
+        deliver(next_event);
+        advance();
+    }
+    on_events(batch);
+
+    schedule();
+    return false;
+}
+
+
+bool
+ReplaySource::on_idle()
+{
+    batch.clear();
+    while (has_next && batch.size() < fast_batch_size) {
+        deliver(next_event);
+        advance();
+    }
+    on_events(batch);
+
+    if (has_next)
+        return true;
+
+    finish();
+    return false;
+}
+
+
+void
+ReplaySource::finish()
+{
+    const double elapsed = (g_get_monotonic_time() - start_wall_time) / double{G_USEC_PER_SEC};
+    cout << "Replayed " << total_events << " events from " << cap_path
+         << " in " << elapsed << " s";
+    if (elapsed > 0)
+        cout << " (" << static_cast<std::uint64_t>(total_events / elapsed) << " events/s)";
+    cout << endl;
+
+    on_stop(_("End of capture."));
+}
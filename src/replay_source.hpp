@@ -0,0 +1,145 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef REPLAY_SOURCE_HPP
+#define REPLAY_SOURCE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <vector>
+
+#include <glibmm.h>
+
+#include "capture.hpp"
+#include "input_source.hpp"
+
+
+/*
+ * Plays back a capture file, as if it was a device.
+ *
+ * With speed = 1 the events are delivered in real time, with speed = N they're N times
+ * faster. With speed <= 0 they're delivered as fast as the GUI can consume them, and
+ * the throughput is reported at the end.
+ */
+class ReplaySource : public InputSource {
+
+    std::filesystem::path cap_path;
+
+    Capture::Reader reader;
+
+    double speed;
+
+    // Simulated kernel state for each axis.
+    std::map<evdev::Code, evdev::AbsInfo> abs;
+
+    EventsSlot on_events;
+    StopSlot on_stop;
+
+    std::vector<input_event> batch;
+
+    sigc::connection timer_conn;
+
+    // The next event to be delivered.
+    input_event next_event;
+    bool has_next = false;
+
+    // Capture time and wall time when the replay started, in microseconds.
+    std::int64_t start_event_time = 0;
+    std::int64_t start_wall_time = 0;
+
+    std::uint64_t total_events = 0;
+
+
+    void
+    advance();
+
+    void
+    deliver(const input_event& event);
+
+    void
+    schedule();
+
+    bool
+    on_timer();
+
+    bool
+    on_idle();
+
+    void
+    finish();
+
+public:
+
+    ReplaySource(const std::filesystem::path& cap_path,
+                 double speed);
+
+    ~ReplaySource()
+        noexcept override;
+
+
+    std::string
+    get_path()
+        const override;
+
+    std::string
+    get_name()
+        const override;
+
+    std::uint16_t
+    get_vendor()
+        const override;
+
+    std::uint16_t
+    get_product()
+        const override;
+
+    std::uint16_t
+    get_version()
+        const override;
+
+
+    clockid_t
+    get_clock()
+        const noexcept override;
+
+
+    std::vector<evdev::Code>
+    get_abs_codes()
+        const override;
+
+    evdev::AbsInfo
+    get_abs_info(evdev::Code code)
+        const override;
+
+    void
+    set_abs_info(evdev::Code code,
+                 const evdev::AbsInfo& info)
+        override;
+
+    std::optional<int>
+    query_abs_value(evdev::Code code)
+        override;
+
+
+    bool
+    is_open()
+        const noexcept override;
+
+
+    void
+    start(EventsSlot on_events,
+          StopSlot on_stop)
+        override;
+
+    void
+    stop()
+        noexcept override;
+
+}; // class ReplaySource
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "report_timing.hpp"
+
+
+void
+ReportTiming::add(std::int64_t time)
+    noexcept
+{
+    if (last_time) {
+        auto interval = time - *last_time;
+        // Ignore time going backwards, e.g. when a capture was edited.
+        if (interval >= 0) {
+            intervals[next] = interval;
+            next = (next + 1) % window;
+            if (count < window)
+                ++count;
+        }
+    }
+    last_time = time;
+}
+
+
+std::optional<ReportTiming::Summary>
+ReportTiming::summarize()
+    const
+{
+    if (!count)
+        return {};
+
+    std::vector<std::int64_t> sorted(intervals.begin(), intervals.begin() + count);
+
+    double sum = 0;
+    for (auto i : sorted)
+        sum += i;
+    const double mean = sum / count;
+
+    double sq = 0;
+    for (auto i : sorted)
+        sq += (i - mean) * (i - mean);
+
+    auto percentile = [&sorted](double p) -> double
+    {
+        auto nth = sorted.begin() + static_cast<std::size_t>(p * (sorted.size() - 1));
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        return *nth;
+    };
+
+    Summary s;
+    s.samples = count;
+    s.mean = mean;
+    s.rate = mean > 0 ? 1'000'000 / mean : 0;
+    s.stddev = std::sqrt(sq / count);
+    s.max = *std::max_element(sorted.begin(), sorted.end());
+    s.p50 = percentile(0.50);
+    s.p99 = percentile(0.99);
+    return s;
+}
@@ -0,0 +1,57 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef REPORT_TIMING_HPP
+#define REPORT_TIMING_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+
+/*
+ * Keeps the intervals between the most recent reports (SYN_REPORT events) of a device,
+ * to measure its effective polling rate and jitter.
+ */
+class ReportTiming {
+
+    static constexpr std::size_t window = 1024;
+
+    // Ring buffer of intervals, in microseconds.
+    std::array<std::int64_t, window> intervals;
+    std::size_t count = 0;
+    std::size_t next = 0;
+
+    std::optional<std::int64_t> last_time;
+
+public:
+
+    // All values in microseconds, except for the rate.
+    struct Summary {
+        std::size_t samples;
+        double rate; // in Hz
+        double mean;
+        double p50;
+        double p99;
+        double max;
+        double stddev;
+    };
+
+
+    // Time of a report, in microseconds.
+    void
+    add(std::int64_t time)
+        noexcept;
+
+    std::optional<Summary>
+    summarize()
+        const;
+
+}; // class ReportTiming
+
+#endif
@@ -10,7 +10,6 @@
 
 #include "settings.hpp"
 
-#include "app.hpp"
 #include "axis_canvas.hpp"
 
 #ifdef HAVE_CONFIG_H
@@ -74,15 +73,19 @@ Settings::on_show()
 
     sample_axis_canvas->reset(sample_info_orig, sample_info_calc);
 
-    sample_timeout_handle = Glib::signal_timeout()
-        .connect(sigc::mem_fun(this, &Settings::animate_axis_sample), 33);
+    sample_frame_time = 0;
+    sample_tick_id = sample_axis_canvas->add_tick_callback(
+        sigc::mem_fun(this, &Settings::animate_axis_sample));
 }
 
 
 void
 Settings::on_hide()
 {
-    sample_timeout_handle.disconnect();
+    if (sample_tick_id) {
+        sample_axis_canvas->remove_tick_callback(sample_tick_id);
+        sample_tick_id = 0;
+    }
     Gtk::ApplicationWindow::on_hide();
 }
 
@@ -110,15 +113,20 @@ namespace {
 
 
 bool
-Settings::animate_axis_sample()
+Settings::animate_axis_sample(const Glib::RefPtr<Gdk::FrameClock>& clock)
 {
+    // Advance by 0.002 * pi every 33 ms, whatever the frame rate is.
+    const gint64 now = clock->get_frame_time();
+    if (sample_frame_time)
+        sample_time += 0.002 * M_PI * (now - sample_frame_time) / 33'000.0;
+    sample_frame_time = now;
+    if (sample_time >= M_PI)
+        sample_time = -M_PI;
+
     double x = std::cos(10 * sample_time) * square(std::sin(sample_time));
     sample_info_calc.val = lerp(sample_info_calc.min,
                                 sample_info_calc.max,
                                 0.5 + x / 2.0);
-    sample_time += 0.002 * M_PI;
-    if (sample_time >= M_PI)
-        sample_time = -M_PI;
     sample_axis_canvas->update(sample_info_calc);
     return true;
 }
@@ -142,40 +150,22 @@ Settings::Settings(BaseObjectType* cobject,
 
     settings = Gio::Settings::create(APPLICATION_ID);
 
-    settings->signal_changed().connect(
-                                       [this, app=App::get_default()](const Glib::ustring& key)
-        {
-            if (key == "background-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_background_color(val);
-                sample_axis_canvas->set_background_color(val);
-            }
-            if (key == "value-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_value_color(val);
-                sample_axis_canvas->set_value_color(val);
-            }
-            if (key == "min-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_min_color(val);
-                sample_axis_canvas->set_min_color(val);
-            }
-            if (key == "max-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_max_color(val);
-                sample_axis_canvas->set_max_color(val);
-            }
-            if (key == "fuzz-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_fuzz_color(val);
-                sample_axis_canvas->set_fuzz_color(val);
-            }
-            if (key == "flat-color") {
-                auto val = Gdk::RGBA{settings->get_string(key)};
-                app->set_flat_color(val);
-                sample_axis_canvas->set_flat_color(val);
-            }
-        });
+    // The App follows the settings by itself; here only the sample needs updating.
+    settings->signal_changed().connect([this](const Glib::ustring& key)
+    {
+        if (key == "background-color")
+            sample_axis_canvas->set_background_color(Gdk::RGBA{settings->get_string(key)});
+        if (key == "value-color")
+            sample_axis_canvas->set_value_color(Gdk::RGBA{settings->get_string(key)});
+        if (key == "min-color")
+            sample_axis_canvas->set_min_color(Gdk::RGBA{settings->get_string(key)});
+        if (key == "max-color")
+            sample_axis_canvas->set_max_color(Gdk::RGBA{settings->get_string(key)});
+        if (key == "fuzz-color")
+            sample_axis_canvas->set_fuzz_color(Gdk::RGBA{settings->get_string(key)});
+        if (key == "flat-color")
+            sample_axis_canvas->set_flat_color(Gdk::RGBA{settings->get_string(key)});
+    });
 
     g_settings_bind_with_mapping(settings->gobj(), "background-color",
                                  background_color_button->gobj(), "rgba",
@@ -208,20 +198,12 @@ Settings::Settings(BaseObjectType* cobject,
                                  string_to_rgba, rgba_to_string,
                                  nullptr, nullptr);
 
-    auto initialize_colors = [](auto target,
-                                const Glib::RefPtr<Gio::Settings>& settings)
-    {
-        target->set_background_color(Gdk::RGBA{settings->get_string("background-color")});
-        target->set_value_color(Gdk::RGBA{settings->get_string("value-color")});
-        target->set_min_color(Gdk::RGBA{settings->get_string("min-color")});
-        target->set_max_color(Gdk::RGBA{settings->get_string("max-color")});
-        target->set_fuzz_color(Gdk::RGBA{settings->get_string("fuzz-color")});
-        target->set_flat_color(Gdk::RGBA{settings->get_string("flat-color")});
-    };
-    // Set the initial values into the App class
-    initialize_colors(App::get_default(), settings);
-    // Do the same with sample_axis_canvas
-    initialize_colors(sample_axis_canvas, settings);
+    sample_axis_canvas->set_background_color(Gdk::RGBA{settings->get_string("background-color")});
+    sample_axis_canvas->set_value_color(Gdk::RGBA{settings->get_string("value-color")});
+    sample_axis_canvas->set_min_color(Gdk::RGBA{settings->get_string("min-color")});
+    sample_axis_canvas->set_max_color(Gdk::RGBA{settings->get_string("max-color")});
+    sample_axis_canvas->set_fuzz_color(Gdk::RGBA{settings->get_string("fuzz-color")});
+    sample_axis_canvas->set_flat_color(Gdk::RGBA{settings->get_string("flat-color")});
 
 
     add_action("close", sigc::mem_fun(this, &Settings::on_action_close));
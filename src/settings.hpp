@@ -28,7 +28,8 @@ class Settings : public Gtk::ApplicationWindow {
     evdev::AbsInfo sample_info_orig;
     evdev::AbsInfo sample_info_calc;
     double sample_time = 0;
-    sigc::connection sample_timeout_handle;
+    gint64 sample_frame_time = 0;
+    guint sample_tick_id = 0;
 
     Glib::RefPtr<Gio::Settings> settings;
 
@@ -43,7 +44,7 @@ class Settings : public Gtk::ApplicationWindow {
 
 
     bool
-    animate_axis_sample();
+    animate_axis_sample(const Glib::RefPtr<Gdk::FrameClock>& clock);
 
 public:
 
@@ -0,0 +1,92 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+
+/*
+ * Fixed-size, lock-free ring buffer, for exactly one producer thread and one consumer
+ * thread.
+ *
+ * The indices grow without bound, and are masked on access, so N must be a power of
+ * two.
+ */
+template<typename T,
+         std::size_t N>
+class SPSCRing {
+
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of two.");
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    static constexpr std::size_t mask = N - 1;
+
+    // Written only by the consumer.
+    alignas(64) std::atomic<std::size_t> head = 0;
+
+    // Written only by the producer.
+    alignas(64) std::atomic<std::size_t> tail = 0;
+
+    alignas(64) std::array<T, N> buffer;
+
+public:
+
+    static constexpr
+    std::size_t
+    capacity()
+        noexcept
+    {
+        return N;
+    }
+
+
+    // Producer side. Returns false if the ring is full.
+    bool
+    push(const T& item)
+        noexcept
+    {
+        const std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == N)
+            return false;
+        buffer[t & mask] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+
+    // Consumer side. Moves up to max_items into out, returns how many were moved.
+    std::size_t
+    pop(T* out,
+        std::size_t max_items)
+        noexcept
+    {
+        const std::size_t h = head.load(std::memory_order_relaxed);
+        const std::size_t available = tail.load(std::memory_order_acquire) - h;
+        const std::size_t count = available < max_items ? available : max_items;
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = buffer[(h + i) & mask];
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+
+    bool
+    empty()
+        const noexcept
+    {
+        return head.load(std::memory_order_acquire)
+            == tail.load(std::memory_order_acquire);
+    }
+
+}; // class SPSCRing
+
+#endif
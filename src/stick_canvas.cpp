@@ -0,0 +1,111 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <libevdevxx/Event.hpp>
+
+#include "stick_canvas.hpp"
+
+#include "redraw_scheduler.hpp"
+
+
+using evdev::AbsInfo;
+using evdev::Code;
+
+
+namespace {
+
+    constexpr int view_size = 160;
+
+} // namespace
+
+
+StickCanvas::StickCanvas(Code x_code_,
+                         const AbsInfo& x_info,
+                         Code y_code_,
+                         const AbsInfo& y_info) :
+    x_code{x_code_},
+    y_code{y_code_},
+    renderer{x_info, y_info}
+{
+    set_size_request(view_size, view_size);
+    set_tooltip_text(evdev::code_to_string(evdev::Type::abs, x_code)
+                     + " / "
+                     + evdev::code_to_string(evdev::Type::abs, y_code));
+}
+
+
+StickCanvas::~StickCanvas()
+    noexcept
+{
+    RedrawScheduler::get().cancel(*this);
+}
+
+
+Code
+StickCanvas::get_x_code()
+    const noexcept
+{
+    return x_code;
+}
+
+
+Code
+StickCanvas::get_y_code()
+    const noexcept
+{
+    return y_code;
+}
+
+
+bool
+StickCanvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+{
+    renderer.draw(cr, get_allocated_width(), get_allocated_height());
+    return true;
+}
+
+
+void
+StickCanvas::schedule_draw()
+{
+    RedrawScheduler::get().queue_draw(*this);
+}
+
+
+void
+StickCanvas::add_point(int x,
+                       int y)
+{
+    staged.push_back({x, y});
+}
+
+
+void
+StickCanvas::flush()
+{
+    if (staged.empty())
+        return;
+    renderer.add_points(staged);
+    staged.clear();
+    schedule_draw();
+}
+
+
+void
+StickCanvas::clear()
+{
+    renderer.clear();
+    schedule_draw();
+}
+
+
+void
+StickCanvas::set_colors(const Colors& c)
+{
+    renderer.set_colors(c);
+    schedule_draw();
+}
@@ -0,0 +1,81 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef STICK_CANVAS_HPP
+#define STICK_CANVAS_HPP
+
+#include <vector>
+
+#include <gtkmm.h>
+#include <cairomm/cairomm.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+#include <libevdevxx/Code.hpp>
+
+#include "colors.hpp"
+#include "stick_renderer.hpp"
+
+
+// 2D view of a pair of axes.
+class StickCanvas : public Gtk::DrawingArea {
+
+    evdev::Code x_code;
+    evdev::Code y_code;
+
+    StickRenderer renderer;
+
+    // Points received since the last flush().
+    std::vector<StickHeatmap::Point> staged;
+
+
+    bool
+    on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+        override;
+
+    // Redraws on the next frame, through the RedrawScheduler.
+    void
+    schedule_draw();
+
+public:
+
+    StickCanvas(evdev::Code x_code,
+                const evdev::AbsInfo& x_info,
+                evdev::Code y_code,
+                const evdev::AbsInfo& y_info);
+
+    ~StickCanvas()
+        noexcept override;
+
+
+    evdev::Code
+    get_x_code()
+        const noexcept;
+
+    evdev::Code
+    get_y_code()
+        const noexcept;
+
+
+    // Stage a position; it's only accounted for by flush().
+    void
+    add_point(int x,
+              int y);
+
+    // Adds the staged positions to the heatmap, in one batch.
+    void
+    flush();
+
+    void
+    clear();
+
+
+    void
+    set_colors(const Colors& c);
+
+}; // class StickCanvas
+
+#endif
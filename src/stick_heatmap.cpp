@@ -0,0 +1,131 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <bit>
+
+#include "stick_heatmap.hpp"
+
+
+namespace {
+
+    constexpr unsigned fraction_bits = 16;
+
+
+    std::int64_t
+    make_factor(int min,
+                int max)
+    {
+        const std::int64_t span = std::int64_t{max} - min;
+        if (span <= 0)
+            return 0;
+        // Maps [min, max] to [0, grid_size), so max lands in the last cell.
+        return ((std::int64_t{StickHeatmap::grid_size} << fraction_bits) - 1) / span;
+    }
+
+} // namespace
+
+
+StickHeatmap::StickHeatmap() :
+    counts(grid_size * grid_size),
+    levels(grid_size * grid_size)
+{}
+
+
+unsigned
+StickHeatmap::cell_x(int x)
+    const noexcept
+{
+    auto c = ((std::int64_t{x} - x_min) * x_factor) >> fraction_bits;
+    return std::clamp<std::int64_t>(c, 0, grid_size - 1);
+}
+
+
+unsigned
+StickHeatmap::cell_y(int y)
+    const noexcept
+{
+    auto c = ((std::int64_t{y} - y_min) * y_factor) >> fraction_bits;
+    return std::clamp<std::int64_t>(c, 0, grid_size - 1);
+}
+
+
+void
+StickHeatmap::set_range(int new_x_min, int x_max,
+                        int new_y_min, int y_max)
+{
+    x_min = new_x_min;
+    y_min = new_y_min;
+    x_factor = make_factor(x_min, x_max);
+    y_factor = make_factor(y_min, y_max);
+    clear();
+}
+
+
+void
+StickHeatmap::clear()
+{
+    std::ranges::fill(counts, 0);
+    std::ranges::fill(levels, 0);
+    invalidate();
+}
+
+
+void
+StickHeatmap::invalidate()
+    noexcept
+{
+    dirty.clear();
+    all_dirty = true;
+}
+
+
+void
+StickHeatmap::add(std::span<const Point> points)
+{
+    // First map the whole batch to cells, a loop the compiler can vectorize...
+    batch_cells.resize(points.size());
+    for (std::size_t i = 0; i < points.size(); ++i)
+        batch_cells[i] = cell_y(points[i].y) * grid_size + cell_x(points[i].x);
+
+    // ... then do the scattered increments.
+    for (auto cell : batch_cells) {
+        auto count = ++counts[cell];
+        // The level only changes when the count reaches a power of two.
+        if (count & (count - 1))
+            continue;
+        auto new_level = std::min<unsigned>(std::bit_width(count), max_level);
+        if (new_level == levels[cell])
+            continue;
+        levels[cell] = new_level;
+        if (!all_dirty)
+            dirty.push_back(cell);
+    }
+}
+
+
+unsigned
+StickHeatmap::level(unsigned column,
+                    unsigned row)
+    const noexcept
+{
+    return levels[row * grid_size + column];
+}
+
+
+bool
+StickHeatmap::take_dirty(std::vector<unsigned>& cells)
+{
+    cells.clear();
+    if (all_dirty) {
+        all_dirty = false;
+        dirty.clear();
+        return false;
+    }
+    std::swap(cells, dirty);
+    return true;
+}
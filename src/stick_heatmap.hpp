@@ -0,0 +1,96 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef STICK_HEATMAP_HPP
+#define STICK_HEATMAP_HPP
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+/*
+ * Counts how often each region of a 2D axis pair was visited, in a fixed grid.
+ *
+ * Counts are shown on a log scale: each cell has a level (the bit width of its
+ * count), and only cells whose level changed need to be repainted.
+ */
+class StickHeatmap {
+public:
+
+    static constexpr unsigned grid_size = 64;
+    static constexpr unsigned max_level = 16;
+
+    struct Point {
+        int x;
+        int y;
+    };
+
+private:
+
+    int x_min = 0;
+    int y_min = 0;
+    // Fixed-point factors that map values to cells, with 16 fraction bits.
+    std::int64_t x_factor = 0;
+    std::int64_t y_factor = 0;
+
+    std::vector<std::uint32_t> counts;
+    std::vector<std::uint8_t> levels;
+
+    // Cells whose level changed since the last take_dirty().
+    std::vector<unsigned> dirty;
+    bool all_dirty = true;
+
+    // Scratch space for the cell indices of a batch.
+    std::vector<unsigned> batch_cells;
+
+
+    unsigned
+    cell_x(int x)
+        const noexcept;
+
+    unsigned
+    cell_y(int y)
+        const noexcept;
+
+public:
+
+    StickHeatmap();
+
+
+    // Values outside the range are clamped to the edges. Clears the counts.
+    void
+    set_range(int x_min, int x_max,
+              int y_min, int y_max);
+
+    void
+    clear();
+
+    // Makes the next take_dirty() report all cells.
+    void
+    invalidate()
+        noexcept;
+
+
+    void
+    add(std::span<const Point> points);
+
+
+    // Level of the cell at (column, row), 0 means never visited.
+    unsigned
+    level(unsigned column,
+          unsigned row)
+        const noexcept;
+
+    // Returns the cells (row * grid_size + column) that must be repainted, and forgets them.
+    // If all cells must be repainted, returns false and leaves cells empty.
+    bool
+    take_dirty(std::vector<unsigned>& cells);
+
+}; // class StickHeatmap
+
+#endif
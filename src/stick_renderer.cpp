@@ -0,0 +1,166 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "stick_renderer.hpp"
+
+
+using evdev::AbsInfo;
+
+
+namespace {
+
+    constexpr double margin = 6.5;
+
+
+    void
+    set_color(const Cairo::RefPtr<Cairo::Context>& ctx,
+              const Gdk::RGBA& color)
+    {
+        ctx->set_source_rgba(color.get_red(),
+                             color.get_green(),
+                             color.get_blue(),
+                             color.get_alpha());
+    }
+
+
+    double
+    to_unit(int value,
+            int min,
+            int max)
+    {
+        if (max <= min)
+            return 0.5;
+        return std::clamp((value - min) / double(max - min), 0.0, 1.0);
+    }
+
+} // namespace
+
+
+StickRenderer::StickRenderer(const AbsInfo& x_info,
+                             const AbsInfo& y_info) :
+    x_min{x_info.min},
+    x_max{x_info.max},
+    y_min{y_info.min},
+    y_max{y_info.max},
+    position{x_info.val, y_info.val}
+{
+    heatmap.set_range(x_min, x_max, y_min, y_max);
+    heatmap_surface = Cairo::ImageSurface::create(Cairo::FORMAT_ARGB32,
+                                                  StickHeatmap::grid_size,
+                                                  StickHeatmap::grid_size);
+}
+
+
+void
+StickRenderer::add_points(std::span<const StickHeatmap::Point> points)
+{
+    if (points.empty())
+        return;
+    heatmap.add(points);
+    position = points.back();
+}
+
+
+void
+StickRenderer::clear()
+{
+    heatmap.clear();
+}
+
+
+void
+StickRenderer::set_colors(const Colors& c)
+{
+    colors = c;
+    // Repaint every cell, with the new color.
+    heatmap.invalidate();
+}
+
+
+void
+StickRenderer::paint_cell(unsigned cell)
+{
+    const unsigned column = cell % StickHeatmap::grid_size;
+    const unsigned row = cell / StickHeatmap::grid_size;
+    const double alpha = colors.flat.get_alpha()
+        * heatmap.level(column, row) / StickHeatmap::max_level;
+
+    // Premultiplied ARGB, in native endianness.
+    auto channel = [alpha](double c) -> std::uint32_t
+    {
+        return std::lround(c * alpha * 255);
+    };
+    const std::uint32_t pixel = (channel(1) << 24)
+        | (channel(colors.flat.get_red())   << 16)
+        | (channel(colors.flat.get_green()) <<  8)
+        |  channel(colors.flat.get_blue());
+
+    auto data = heatmap_surface->get_data() + row * heatmap_surface->get_stride();
+    reinterpret_cast<std::uint32_t*>(data)[column] = pixel;
+}
+
+
+void
+StickRenderer::update_surface()
+{
+    heatmap_surface->flush();
+    if (heatmap.take_dirty(dirty_cells)) {
+        for (auto cell : dirty_cells)
+            paint_cell(cell);
+    } else {
+        for (unsigned cell = 0; cell < StickHeatmap::grid_size * StickHeatmap::grid_size; ++cell)
+            paint_cell(cell);
+    }
+    heatmap_surface->mark_dirty();
+}
+
+
+void
+StickRenderer::draw(const Cairo::RefPtr<Cairo::Context>& cr,
+                    int width,
+                    int height)
+{
+    set_color(cr, colors.background);
+    cr->paint();
+
+    const double side = std::floor(std::min(width, height) - 2 * margin);
+    if (side <= 0)
+        return;
+    const double left = std::floor((width - side) / 2) + 0.5;
+    const double top = std::floor((height - side) / 2) + 0.5;
+
+    update_surface();
+    cr->save();
+    cr->translate(left, top);
+    cr->scale(side / StickHeatmap::grid_size, side / StickHeatmap::grid_size);
+    auto pattern = Cairo::SurfacePattern::create(heatmap_surface);
+    pattern->set_filter(Cairo::FILTER_NEAREST);
+    cr->set_source(pattern);
+    cr->paint();
+    cr->restore();
+
+    cr->set_line_width(1);
+
+    // Outline, and the center lines.
+    set_color(cr, colors.fuzz);
+    cr->rectangle(left, top, side, side);
+    cr->move_to(left + std::round(side / 2), top);
+    cr->rel_line_to(0, side);
+    cr->move_to(left, top + std::round(side / 2));
+    cr->rel_line_to(side, 0);
+    cr->stroke();
+
+    const double px = left + side * to_unit(position.x, x_min, x_max);
+    const double py = top + side * to_unit(position.y, y_min, y_max);
+    set_color(cr, colors.value);
+    cr->arc(px, py, 4, 0, 2 * M_PI);
+    cr->stroke();
+}
@@ -0,0 +1,75 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef STICK_RENDERER_HPP
+#define STICK_RENDERER_HPP
+
+#include <span>
+#include <vector>
+
+#include <cairomm/cairomm.h>
+
+#include <libevdevxx/AbsInfo.hpp>
+
+#include "colors.hpp"
+#include "stick_heatmap.hpp"
+
+
+/*
+ * Draws a pair of axes in 2D: the current position, over a heatmap of every position
+ * visited so far.
+ *
+ * The heatmap is kept in a small image, one pixel per cell; only the cells that changed
+ * are repainted before it's scaled into place.
+ */
+class StickRenderer {
+
+    int x_min, x_max;
+    int y_min, y_max;
+
+    StickHeatmap heatmap;
+
+    StickHeatmap::Point position;
+
+    Cairo::RefPtr<Cairo::ImageSurface> heatmap_surface;
+    std::vector<unsigned> dirty_cells;
+
+    Colors colors;
+
+
+    void
+    update_surface();
+
+    void
+    paint_cell(unsigned cell);
+
+public:
+
+    StickRenderer(const evdev::AbsInfo& x_info,
+                  const evdev::AbsInfo& y_info);
+
+
+    // Adds a batch of positions; the last one becomes the current position.
+    void
+    add_points(std::span<const StickHeatmap::Point> points);
+
+    void
+    clear();
+
+
+    void
+    set_colors(const Colors& c);
+
+
+    void
+    draw(const Cairo::RefPtr<Cairo::Context>& cr,
+         int width,
+         int height);
+
+}; // class StickRenderer
+
+#endif
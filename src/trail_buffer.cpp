@@ -0,0 +1,169 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "trail_buffer.hpp"
+
+
+TrailBuffer::TrailBuffer(unsigned bits) :
+    bits{bits},
+    capacity{std::uint64_t{1} << bits},
+    times(capacity),
+    values(capacity)
+{
+    if (bits < 1 || bits > 24)
+        throw std::invalid_argument{"TrailBuffer: invalid capacity"};
+
+    for (unsigned level = 1; level <= bits; ++level)
+        levels.emplace_back(capacity >> level);
+}
+
+
+void
+TrailBuffer::push(std::int64_t time,
+                  int value)
+{
+    if (head && time < latest_time())
+        time = latest_time();
+
+    const std::uint64_t mask = capacity - 1;
+    times[head & mask] = time;
+    values[head & mask] = value;
+
+    // The first sample of a block starts it; the others extend it.
+    for (unsigned level = 1; level <= bits; ++level) {
+        const std::uint64_t block = head >> level;
+        auto& entry = levels[level - 1][block & (mask >> level)];
+        if ((head & ((std::uint64_t{1} << level) - 1)) == 0)
+            entry = {value, value};
+        else {
+            entry.min = std::min(entry.min, value);
+            entry.max = std::max(entry.max, value);
+        }
+    }
+
+    ++head;
+}
+
+
+void
+TrailBuffer::clear()
+    noexcept
+{
+    head = 0;
+}
+
+
+bool
+TrailBuffer::empty()
+    const noexcept
+{
+    return head == 0;
+}
+
+
+std::int64_t
+TrailBuffer::latest_time()
+    const noexcept
+{
+    return times[(head - 1) & (capacity - 1)];
+}
+
+
+std::uint64_t
+TrailBuffer::tail()
+    const noexcept
+{
+    return head > capacity ? head - capacity : 0;
+}
+
+
+std::uint64_t
+TrailBuffer::lower_bound(std::int64_t t)
+    const noexcept
+{
+    const std::uint64_t mask = capacity - 1;
+    std::uint64_t lo = tail();
+    std::uint64_t hi = head;
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        if (times[mid & mask] < t)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+
+bool
+TrailBuffer::last_before(std::int64_t t,
+                         int& value)
+    const noexcept
+{
+    auto idx = lower_bound(t);
+    if (idx == tail())
+        return false;
+    value = values[(idx - 1) & (capacity - 1)];
+    return true;
+}
+
+
+bool
+TrailBuffer::range(std::int64_t t0,
+                   std::int64_t t1,
+                   int& low,
+                   int& high)
+    const noexcept
+{
+    std::uint64_t a = lower_bound(t0);
+    std::uint64_t b = lower_bound(t1);
+    if (a >= b)
+        return false;
+
+    const std::uint64_t mask = capacity - 1;
+    low = values[a & mask];
+    high = low;
+
+    auto merge = [&low, &high](int lo, int hi)
+    {
+        low = std::min(low, lo);
+        high = std::max(high, hi);
+    };
+
+    // Samples at level 0, until a is aligned to the next level.
+    if (a & 1) {
+        merge(values[a & mask], values[a & mask]);
+        ++a;
+    }
+    if (b & 1) {
+        --b;
+        merge(values[b & mask], values[b & mask]);
+    }
+    a >>= 1;
+    b >>= 1;
+
+    // Whole blocks, from the pyramid.
+    for (unsigned level = 1; a < b && level <= bits; ++level) {
+        const auto& lv = levels[level - 1];
+        const std::uint64_t lmask = mask >> level;
+        if (a & 1) {
+            merge(lv[a & lmask].min, lv[a & lmask].max);
+            ++a;
+        }
+        if (b & 1) {
+            --b;
+            merge(lv[b & lmask].min, lv[b & lmask].max);
+        }
+        a >>= 1;
+        b >>= 1;
+    }
+
+    return true;
+}
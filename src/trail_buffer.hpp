@@ -0,0 +1,96 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TRAIL_BUFFER_HPP
+#define TRAIL_BUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/*
+ * Fixed-capacity history of (time, value) samples, with a min/max pyramid.
+ *
+ * Level L of the pyramid holds the min/max of each aligned block of 2^L samples, so the
+ * min/max over any range of samples takes O(log capacity) steps. Drawing a plot then
+ * costs O(pixels), no matter how many samples each pixel covers.
+ *
+ * Times must not decrease; older times are clamped to the latest one.
+ */
+class TrailBuffer {
+
+    struct MinMax {
+        int min;
+        int max;
+    };
+
+    unsigned bits;
+    std::uint64_t capacity;
+
+    std::vector<std::int64_t> times;
+    std::vector<int> values;
+
+    // levels[L - 1] is level L; it has capacity >> L entries.
+    std::vector<std::vector<MinMax>> levels;
+
+    // Logical index of the next sample; the oldest one is max(head, capacity) - capacity.
+    std::uint64_t head = 0;
+
+
+    std::uint64_t
+    tail()
+        const noexcept;
+
+    // First logical index in [tail(), head] with time >= t.
+    std::uint64_t
+    lower_bound(std::int64_t t)
+        const noexcept;
+
+public:
+
+    // Holds up to 2^bits samples.
+    explicit
+    TrailBuffer(unsigned bits = 16);
+
+
+    void
+    push(std::int64_t time,
+         int value);
+
+    void
+    clear()
+        noexcept;
+
+
+    bool
+    empty()
+        const noexcept;
+
+    // Time of the latest sample; only valid if not empty.
+    std::int64_t
+    latest_time()
+        const noexcept;
+
+
+    // Value of the last sample with time < t. Returns false if there is none.
+    bool
+    last_before(std::int64_t t,
+                int& value)
+        const noexcept;
+
+    // Min/max of the values with time in [t0, t1). Returns false if there are none.
+    bool
+    range(std::int64_t t0,
+          std::int64_t t1,
+          int& low,
+          int& high)
+        const noexcept;
+
+}; // class TrailBuffer
+
+#endif
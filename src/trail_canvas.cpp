@@ -0,0 +1,98 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "trail_canvas.hpp"
+
+#include "redraw_scheduler.hpp"
+
+
+TrailCanvas::TrailCanvas(BaseObjectType* cobject,
+                         const Glib::RefPtr<Gtk::Builder>& /* builder */) :
+    Gtk::DrawingArea{cobject}
+{}
+
+
+TrailCanvas::~TrailCanvas()
+    noexcept
+{
+    RedrawScheduler::get().cancel(*this);
+}
+
+
+bool
+TrailCanvas::on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+{
+    renderer.draw(cr, get_allocated_width(), get_allocated_height());
+    return true;
+}
+
+
+void
+TrailCanvas::schedule_draw()
+{
+    RedrawScheduler::get().queue_draw(*this);
+}
+
+
+void
+TrailCanvas::set_enabled(bool enabled)
+{
+    if (enabled == is_enabled())
+        return;
+    renderer.set_enabled(enabled);
+    set_visible(enabled);
+    schedule_draw();
+}
+
+
+bool
+TrailCanvas::is_enabled()
+    const noexcept
+{
+    return renderer.is_enabled();
+}
+
+
+void
+TrailCanvas::add_sample(std::int64_t time,
+                        int value)
+{
+    renderer.add_sample(time, value);
+}
+
+
+void
+TrailCanvas::set_end_time(std::int64_t time)
+{
+    if (renderer.set_end_time(time))
+        schedule_draw();
+}
+
+
+void
+TrailCanvas::set_range(int low,
+                       int high)
+{
+    if (renderer.set_range(low, high))
+        schedule_draw();
+}
+
+
+void
+TrailCanvas::clear()
+{
+    if (renderer.clear())
+        schedule_draw();
+}
+
+
+void
+TrailCanvas::set_colors(const Colors& c)
+{
+    renderer.set_colors(c);
+    schedule_draw();
+}
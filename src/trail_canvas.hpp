@@ -0,0 +1,73 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TRAIL_CANVAS_HPP
+#define TRAIL_CANVAS_HPP
+
+#include <cstdint>
+
+#include <gtkmm.h>
+#include <cairomm/cairomm.h>
+
+#include "colors.hpp"
+#include "trail_renderer.hpp"
+
+
+// Scrolling plot of an axis' values over the last few seconds.
+class TrailCanvas : public Gtk::DrawingArea {
+
+    TrailRenderer renderer;
+
+
+    bool
+    on_draw(const Cairo::RefPtr<Cairo::Context>& cr)
+        override;
+
+    // Redraws on the next frame, through the RedrawScheduler.
+    void
+    schedule_draw();
+
+public:
+
+    TrailCanvas(BaseObjectType* cobject,
+                const Glib::RefPtr<Gtk::Builder>& /* builder */);
+
+    ~TrailCanvas()
+        noexcept override;
+
+
+    // Shows or hides the canvas; a disabled trail discards its history.
+    void
+    set_enabled(bool enabled);
+
+    bool
+    is_enabled()
+        const noexcept;
+
+
+    void
+    add_sample(std::int64_t time,
+               int value);
+
+    // Scrolls the plot so it ends at this time.
+    void
+    set_end_time(std::int64_t time);
+
+    void
+    set_range(int low,
+              int high);
+
+    void
+    clear();
+
+
+    void
+    set_colors(const Colors& c);
+
+}; // class TrailCanvas
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <algorithm>
+
+#include "trail_renderer.hpp"
+
+
+namespace {
+
+    // How much history is visible, in microseconds.
+    constexpr std::int64_t visible_time = 10'000'000;
+
+    // 2^14 samples: the visible 10 seconds, at up to 1.6 kHz.
+    constexpr unsigned capacity_bits = 14;
+
+
+    void
+    set_color(const Cairo::RefPtr<Cairo::Context>& ctx,
+              const Gdk::RGBA& color)
+    {
+        ctx->set_source_rgba(color.get_red(),
+                             color.get_green(),
+                             color.get_blue(),
+                             color.get_alpha());
+    }
+
+} // namespace
+
+
+void
+TrailRenderer::set_enabled(bool enabled)
+{
+    if (enabled == is_enabled())
+        return;
+
+    if (enabled)
+        buffer = std::make_unique<TrailBuffer>(capacity_bits);
+    else
+        buffer.reset();
+}
+
+
+bool
+TrailRenderer::is_enabled()
+    const noexcept
+{
+    return bool(buffer);
+}
+
+
+void
+TrailRenderer::add_sample(std::int64_t time,
+                          int value)
+{
+    if (buffer)
+        buffer->push(time, value);
+}
+
+
+bool
+TrailRenderer::set_end_time(std::int64_t time)
+{
+    if (!buffer || time == end_time)
+        return false;
+    end_time = time;
+    return true;
+}
+
+
+bool
+TrailRenderer::set_range(int new_low,
+                         int new_high)
+{
+    if (new_low == low && new_high == high)
+        return false;
+    low = new_low;
+    high = new_high;
+    return bool(buffer);
+}
+
+
+bool
+TrailRenderer::clear()
+{
+    if (!buffer)
+        return false;
+    buffer->clear();
+    return true;
+}
+
+
+void
+TrailRenderer::set_colors(const Colors& c)
+{
+    colors = c;
+}
+
+
+void
+TrailRenderer::draw(const Cairo::RefPtr<Cairo::Context>& cr,
+                    int width,
+                    int height)
+    const
+{
+    set_color(cr, colors.background);
+    cr->paint();
+
+    if (!buffer || buffer->empty() || width <= 0 || high <= low)
+        return;
+
+    const double scale = (height - 1) / double(high - low);
+    auto to_y = [this, scale](int value)
+    {
+        return (high - std::clamp(value, low, high)) * scale + 0.5;
+    };
+
+    const std::int64_t start_time = end_time - visible_time;
+    auto column_time = [start_time, width](int x)
+    {
+        return start_time + visible_time * x / width;
+    };
+
+    // The value held since before the current column started.
+    int held = 0;
+    bool has_held = buffer->last_before(start_time, held);
+
+    for (int x = 0; x < width; ++x) {
+        const auto t0 = column_time(x);
+        const auto t1 = column_time(x + 1);
+
+        int col_low, col_high;
+        if (buffer->range(t0, t1, col_low, col_high)) {
+            if (has_held) {
+                col_low = std::min(col_low, held);
+                col_high = std::max(col_high, held);
+            }
+        } else if (has_held)
+            col_low = col_high = held;
+        else
+            continue;
+
+        // Extend by half a pixel, so constant values are still visible.
+        cr->move_to(x + 0.5, to_y(col_high) - 0.5);
+        cr->line_to(x + 0.5, to_y(col_low) + 0.5);
+
+        has_held = buffer->last_before(t1, held);
+    }
+
+    set_color(cr, colors.value);
+    cr->set_line_width(1);
+    cr->stroke();
+}
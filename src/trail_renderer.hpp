@@ -0,0 +1,79 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef TRAIL_RENDERER_HPP
+#define TRAIL_RENDERER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include <cairomm/cairomm.h>
+
+#include "colors.hpp"
+#include "trail_buffer.hpp"
+
+
+/*
+ * Draws an axis' values over the last few seconds.
+ *
+ * Each pixel column shows the min/max of the samples it covers, so drawing doesn't
+ * depend on the report rate. The buffer is only allocated while the trail is enabled.
+ */
+class TrailRenderer {
+
+    std::unique_ptr<TrailBuffer> buffer;
+
+    // Time at the right edge, in microseconds.
+    std::int64_t end_time = 0;
+
+    // Values at the bottom and top edges.
+    int low = 0;
+    int high = 0;
+
+    Colors colors;
+
+public:
+
+    // A disabled trail discards its history.
+    void
+    set_enabled(bool enabled);
+
+    bool
+    is_enabled()
+        const noexcept;
+
+
+    void
+    add_sample(std::int64_t time,
+               int value);
+
+    // These return true if the plot changed.
+
+    bool
+    set_end_time(std::int64_t time);
+
+    bool
+    set_range(int low,
+              int high);
+
+    bool
+    clear();
+
+
+    void
+    set_colors(const Colors& c);
+
+
+    void
+    draw(const Cairo::RefPtr<Cairo::Context>& cr,
+         int width,
+         int height)
+        const;
+
+}; // class TrailRenderer
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+
+#include "update_batch.hpp"
+
+
+using std::cerr;
+using std::endl;
+
+
+UpdateBatch::UpdateBatch(Slot on_flush_) :
+    on_flush{std::move(on_flush_)}
+{}
+
+
+void
+UpdateBatch::flush()
+{
+    pending = false;
+    ++flushes;
+    on_flush();
+}
+
+
+void
+UpdateBatch::begin()
+    noexcept
+{
+    ++depth;
+}
+
+
+void
+UpdateBatch::commit()
+{
+    if (!depth)
+        throw std::logic_error{"UpdateBatch::commit() without begin()"};
+    if (--depth == 0 && pending)
+        flush();
+}
+
+
+void
+UpdateBatch::changed()
+{
+    ++changes;
+    if (depth)
+        pending = true;
+    else
+        flush();
+}
+
+
+bool
+UpdateBatch::is_active()
+    const noexcept
+{
+    return depth > 0;
+}
+
+
+std::uint64_t
+UpdateBatch::get_changes()
+    const noexcept
+{
+    return changes;
+}
+
+
+std::uint64_t
+UpdateBatch::get_flushes()
+    const noexcept
+{
+    return flushes;
+}
+
+
+UpdateBatch::Guard::Guard(UpdateBatch& batch_)
+    noexcept :
+    batch(batch_)
+{
+    batch.begin();
+}
+
+
+UpdateBatch::Guard::~Guard()
+    noexcept
+{
+    try {
+        batch.commit();
+    }
+    catch (std::exception& e) {
+        cerr << "Failed to commit update: " << e.what() << endl;
+    }
+}
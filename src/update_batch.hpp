@@ -0,0 +1,95 @@
+/*
+ * calibrate-joystick - a program to calibrate joysticks on Linux
+ *
+ * Copyright (C) 2025  Daniel K. O.
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#ifndef UPDATE_BATCH_HPP
+#define UPDATE_BATCH_HPP
+
+#include <cstdint>
+#include <functional>
+
+
+/*
+ * Coalesces changes into a single flush.
+ *
+ * Outside of a batch, every change is flushed immediately. Between begin() and commit()
+ * the changes are only recorded, and the outermost commit() flushes once, if anything
+ * changed. Batches can be nested.
+ */
+class UpdateBatch {
+
+public:
+
+    using Slot = std::function<void()>;
+
+private:
+
+    Slot on_flush;
+
+    unsigned depth = 0;
+    bool pending = false;
+
+    std::uint64_t changes = 0;
+    std::uint64_t flushes = 0;
+
+
+    void
+    flush();
+
+public:
+
+    explicit
+    UpdateBatch(Slot on_flush);
+
+
+    void
+    begin()
+        noexcept;
+
+    void
+    commit();
+
+    void
+    changed();
+
+
+    bool
+    is_active()
+        const noexcept;
+
+
+    // Counters, to check how well changes are being coalesced.
+
+    std::uint64_t
+    get_changes()
+        const noexcept;
+
+    std::uint64_t
+    get_flushes()
+        const noexcept;
+
+
+    // Calls begin() on construction, and commit() on destruction.
+    class Guard {
+
+        UpdateBatch& batch;
+
+    public:
+
+        explicit
+        Guard(UpdateBatch& batch)
+            noexcept;
+
+        ~Guard()
+            noexcept;
+
+        Guard(const Guard&) = delete;
+
+    }; // class Guard
+
+}; // class UpdateBatch
+
+#endif